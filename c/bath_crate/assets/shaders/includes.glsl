@@ -35,4 +35,51 @@ layout(location = 1) in vec4 vtx_c;
 layout(location = 2) in vec4 vtx_t0;
 #endif
 
-#endif
\ No newline at end of file
+#endif
+
+
+#ifdef VTX_PACKED
+
+#ifdef __vert__
+//quantized vertex, see vertexpack.h: MyGL's attributes are floats, so each word carries two integers as
+//lo + hi * 65536, exact below 2^24
+layout(location = 0) in vec4 vtx_w;  //x | z low, y | z high, u | normal x, v | normal y
+
+//the UVs' dequantization, set per mesh from the packer's UV bounds
+uniform float uv_min_u = 0.0;
+uniform float uv_min_v = 0.0;
+uniform float uv_ext_u = 1.0;
+uniform float uv_ext_v = 1.0;
+
+vec4 vtx_hi(){
+  return floor( vtx_w / 65536.0 );
+}
+
+vec4 vtx_lo(){
+  return vtx_w - vtx_hi() * 65536.0;
+}
+
+//unorm16 xyz relative to the mesh bounds, [0, 1]
+vec4 vtx_p_unpack(){
+  vec4 lo = vtx_lo();
+  vec4 hi = vtx_hi();
+  return vec4( vec3( lo.x, lo.y, hi.x + hi.y * 256.0 ) / 65535.0, 1.0 );
+}
+
+//snorm8 octahedral normal, stored + 128
+vec3 vtx_n_unpack(){
+  vec2 o = max( ( vtx_hi().zw - 128.0 ) / 127.0, vec2( -1.0 ) );
+  vec3 n = vec3( o, 1.0 - abs( o.x ) - abs( o.y ) );
+  float t = max( -n.z, 0.0 );
+  n.xy += vec2( n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t );
+  return normalize( n );
+}
+
+//unorm16 uv relative to the UV bounds
+vec4 vtx_t_unpack(){
+  vec2 t = vtx_lo().zw / 65535.0;
+  return vec4( uv_min_u + t.x * uv_ext_u, uv_min_v + t.y * uv_ext_v, 0.0, 0.0 );
+}
+#endif
+
+#endif
\ No newline at end of file
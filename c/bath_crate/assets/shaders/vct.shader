@@ -17,14 +17,13 @@ Stencil Always WriteMask.AllBits Value.1 ValueMask.AllBits StencilFail.Keep Sten
 **/
 
 #define TRANSFORM
+#define VTX_PACKED
 #include "includes.glsl"
 
 #ifdef __vert__
 
-layout(location = 0) in vec4 vtx_p;
-
 void main(){
-  gl_Position = PVW * vtx_p;
+  gl_Position = PVW * vtx_p_unpack();
 }
 
 #endif
@@ -48,7 +47,7 @@ Depth Equal ReadOnly
 **/
 
 #define TRANSFORM
-#define VTX_P_C_T0
+#define VTX_PACKED
 #include "includes.glsl"
 
 vary vec4 var_c;
@@ -57,9 +56,9 @@ vary vec4 var_t;
 #ifdef __vert__
 
 void main(){
-  gl_Position = PVW * vtx_p;
-  var_c = vtx_c;
-  var_t = vtx_t0;
+  gl_Position = PVW * vtx_p_unpack();
+  var_c = vec4( 1.0 );
+  var_t = vtx_t_unpack();
 }
 
 #endif
@@ -86,7 +85,7 @@ Depth Equal ReadOnly
 **/
 
 #define TRANSFORM
-#define VTX_P_C_T0
+#define VTX_PACKED
 #include "includes.glsl"
 
 vary vec4 var_c;
@@ -95,9 +94,9 @@ vary vec4 var_t;
 #ifdef __vert__
 
 void main(){
-  gl_Position = PVW * vtx_p;
-  var_c = vtx_c;
-  var_t = vtx_t0;
+  gl_Position = PVW * vtx_p_unpack();
+  var_c = vec4( 1.0 );
+  var_t = vtx_t_unpack();
 }
 
 #endif
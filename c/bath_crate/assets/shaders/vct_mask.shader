@@ -16,7 +16,7 @@ Stencil Equal WriteMask.NoBits Value.3 ValueMask.AllBits StencilFail.Keep Stenci
 **/
 
 #define TRANSFORM
-#define VTX_P_C_T0
+#define VTX_PACKED
 #include "includes.glsl"
 
 vary vec4 var_c;
@@ -25,9 +25,9 @@ vary vec4 var_t;
 #ifdef __vert__
 
 void main(){
-  gl_Position = PVW * vtx_p;
-  var_c = vtx_c;
-  var_t = vtx_t0;
+  gl_Position = PVW * vtx_p_unpack();
+  var_c = vec4( 1.0 );
+  var_t = vtx_t_unpack();
 }
 
 #endif
@@ -1,5 +1,5 @@
-#pragma once
-
-#include "bitmap.h"
-
-extern void load_font( const char name[] );
+#pragma once
+
+#include "bitmap.h"
+
+extern void load_font( const char name[] );
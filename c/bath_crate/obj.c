@@ -1,168 +1,478 @@
-#include "obj.h"
-
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-
-void WaveFront_obj_term( WaveFront_obj_t *obj ){
-  if( obj->verts )
-    free( obj->verts );
-  if( obj->uvs )
-    free( obj->uvs );
-  if( obj->norms )
-    free( obj->norms );
-  if( obj->faces )
-    free( obj->faces );
-  memset( obj, 0, sizeof(WaveFront_obj_t) );
-}
-
-static void parse_indices( const char *tok, int *v, int *t, int *n ){
-  char str[64];
-  char *tptr = NULL;
-  char *nptr = NULL;
-  int i;
-
-  *v = *t = *n = -1;
-
-  strcpy( str, tok );
-  for( i = 0; str[i] != '\0'; i++ ){
-    if( '/' == str[i] ){
-      str[i] = '\0';
-      tptr = &str[i+1];
-      break;
-    }
-  }
-  for( ; str[i] != '\0'; i++ ){
-    if( '/' == str[i] ){
-      str[i] = '\0';
-      nptr = &str[i+1];
-      break;
-    }
-  }
-
-  *v = atoi( str ) - 1;
-  if( tptr && *tptr != '\0' )
-    *t = atoi( tptr ) - 1;
-  if( nptr && *nptr != '\0' )
-    *n = atoi( nptr ) - 1;
-}
-
-
-int WaveFront_obj_load( WaveFront_obj_t *obj, const char objfile[], float scale, int term ){
-  if( term )
-    WaveFront_obj_term( obj );
-  else
-    memset( obj, 0, sizeof(WaveFront_obj_t) );
-
-  if( scale <= 0.0f )
-    scale = 1.0f;
-
-  FILE *fp = NULL;
-  char line[256];
-  fp = fopen( objfile, "r" );
-  if( !fp ){
-    printf( "%s - invalid OBJ file '%s'\n", __FUNCTION__, objfile );
-    return 0;
-  }
-  strcpy( obj->name, objfile );
-
-  obj->num_verts = 0;
-  obj->num_uvs = 0;
-  obj->num_norms = 0;
-  obj->num_faces = 0;
-  while( 1 ){
-    memset( line, 0, sizeof(line) );
-    if( NULL == fgets( line, sizeof(line), fp ) )
-      break;
-
-    if( 'v' == line[0] &&
-        ' ' == line[1] )
-      obj->num_verts++;
-    else
-    if( 'v' == line[0] &&
-        'n' == line[1] )
-      obj->num_norms++;
-    else
-    if( 'v' == line[0] &&
-        't' == line[1] )
-      obj->num_uvs++;
-    else
-    if( 'f' == line[0] &&
-        ' ' == line[1] )
-      obj->num_faces++;
-  }
-  fseek( fp, 0, SEEK_SET );
-
-  obj->verts = malloc( obj->num_verts * sizeof(WaveFront_vec3_t) );
-  if( obj->num_uvs )
-    obj->uvs = malloc( obj->num_uvs * sizeof(WaveFront_vec2_t) );
-  if( obj->num_norms )
-    obj->norms = malloc( obj->num_norms * sizeof(WaveFront_vec3_t) );
-  obj->faces = malloc( obj->num_faces * sizeof(WaveFront_face_t) );
-
-  int vi  = 0;
-  int vni = 0;
-  int vti = 0;
-  int fi  = 0;
-  while( 1 ){
-    memset( line, 0, sizeof(line) );
-    if( NULL == fgets( line, sizeof(line), fp ) )
-      break;
-
-    if( 'v' == line[0] &&
-        ' ' == line[1] ){
-      char *ptr = &line[2];
-      while( *ptr == ' ' )
-        ptr++;
-      WaveFront_vec3_t *v = &obj->verts[vi++];
-      sscanf( ptr, "%f %f %f", &v->x, &v->y, & v->z );
-      v->x *= scale;
-      v->y *= scale;
-      v->z *= scale;
-    }
-    else
-    if( 'v' == line[0] &&
-        'n' == line[1] ){
-      char *ptr = &line[3];
-      while( *ptr == ' ' )
-        ptr++;
-      WaveFront_vec3_t *n = &obj->norms[vni++];
-      sscanf( ptr, "%f %f %f", &n->x, &n->y, & n->z );
-    }
-    else
-    if( 'v' == line[0] &&
-        't' == line[1] ){
-      char *ptr = &line[3];
-      while( *ptr == ' ' )
-        ptr++;
-      WaveFront_vec2_t *t = &obj->uvs[vti++];
-      sscanf( ptr, "%f %f", &t->x, &t->y );
-    }
-    else
-    if( 'f' == line[0] &&
-        ' ' == line[1] ){
-      WaveFront_face_t *f = &obj->faces[fi++];
-      char *ptr = &line[2];
-      while( *ptr == ' ' )
-        ptr++;
-      char *tok = strtok( ptr, " \n" );
-      parse_indices( tok, &f->vs[0], &f->ts[0], &f->ns[0] );
-      tok = strtok( NULL, " \n" );
-      parse_indices( tok, &f->vs[1], &f->ts[1], &f->ns[1] );
-      tok = strtok( NULL, " \n" );
-      parse_indices( tok, &f->vs[2], &f->ts[2], &f->ns[2] );
-    }
-  }
-
-  fclose( fp );
-  fp = NULL;
-
-  printf( "%s - OBJ '%s' loaded: %u verts, %d normals, %u tex-coords, %u faces\n",
-          __FUNCTION__,
-          obj->name,
-          obj->num_verts,
-          obj->num_norms,
-          obj->num_uvs,
-          obj->num_faces );
-  return 1;
-}
+#include "obj.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+void WaveFront_obj_term( WaveFront_obj_t *obj ){
+  if( obj->arena )
+    free( obj->arena );
+  memset( obj, 0, sizeof(WaveFront_obj_t) );
+}
+
+
+/*
+ * arena: one block holding the verts, uvs, norms and faces sections back to back.
+ * a full section doubles its capacity in place, the block is realloc'ed and the
+ * sections after it are slid up. once parsing is done, the sections are packed
+ * and the block is shrunk to fit, so a loaded OBJ owns exactly one allocation.
+ */
+
+#define OBJ_VERTS         0
+#define OBJ_UVS           1
+#define OBJ_NORMS         2
+#define OBJ_FACES         3
+#define OBJ_NUM_SECTIONS  4
+
+static const size_t section_size[ OBJ_NUM_SECTIONS ] = {
+    sizeof(WaveFront_vec3_t),
+    sizeof(WaveFront_vec2_t),
+    sizeof(WaveFront_vec3_t),
+    sizeof(WaveFront_face_t),
+};
+
+typedef struct{
+  char     *base;
+  uint32_t  num[ OBJ_NUM_SECTIONS ];
+  uint32_t  cap[ OBJ_NUM_SECTIONS ];
+}WaveFront_arena_t;
+
+static size_t arena_offset( const uint32_t *cap, int section ){
+  size_t offset = 0;
+  for( int s = 0; s < section; s++ )
+    offset += cap[s] * section_size[s];
+  return offset;
+}
+
+//returns 0 if the block can't be allocated
+static int arena_init( WaveFront_arena_t *a, size_t text_size ){
+  memset( a, 0, sizeof(WaveFront_arena_t) );
+  uint32_t cap = (uint32_t)( text_size / 128 );
+  if( cap < 64 )
+    cap = 64;
+  for( int s = 0; s < OBJ_NUM_SECTIONS; s++ )
+    a->cap[s] = cap;
+  a->base = malloc( arena_offset( a->cap, OBJ_NUM_SECTIONS ) );
+  return NULL != a->base;
+}
+
+//returns 0, leaving the arena as it was, if a growing block can't be realloc'ed
+static int arena_layout( WaveFront_arena_t *a, const uint32_t *cap ){
+  uint32_t old_cap[ OBJ_NUM_SECTIONS ];
+  memcpy( old_cap, a->cap, sizeof(old_cap) );
+  size_t old_size = arena_offset( old_cap, OBJ_NUM_SECTIONS );
+  size_t new_size = arena_offset( cap, OBJ_NUM_SECTIONS );
+
+  if( new_size > old_size ){
+    char *base = realloc( a->base, new_size );
+    if( !base )
+      return 0;
+    a->base = base;
+    //growing, sections only move up: slide the last one first
+    for( int s = OBJ_NUM_SECTIONS - 1; s > 0; s-- )
+      memmove( a->base + arena_offset( cap, s ), a->base + arena_offset( old_cap, s ), a->num[s] * section_size[s] );
+  }
+  else{
+    //shrinking, sections only move down: slide the first one first
+    for( int s = 1; s < OBJ_NUM_SECTIONS; s++ )
+      memmove( a->base + arena_offset( cap, s ), a->base + arena_offset( old_cap, s ), a->num[s] * section_size[s] );
+    //a failed shrink keeps the larger block, which still holds the new layout
+    char *base = new_size ? realloc( a->base, new_size ) : ( free( a->base ), NULL );
+    if( base || !new_size )
+      a->base = base;
+  }
+  memcpy( a->cap, cap, sizeof(a->cap) );
+  return 1;
+}
+
+//returns NULL if the section is full and can't grow
+static void *arena_push( WaveFront_arena_t *a, int section ){
+  if( a->num[section] == a->cap[section] ){
+    uint32_t cap[ OBJ_NUM_SECTIONS ];
+    memcpy( cap, a->cap, sizeof(cap) );
+    cap[section] *= 2;
+    if( !arena_layout( a, cap ) )
+      return NULL;
+  }
+  return a->base + arena_offset( a->cap, section ) + a->num[section]++ * section_size[section];
+}
+
+static void arena_pack( WaveFront_arena_t *a ){
+  arena_layout( a, a->num );
+}
+
+static void *arena_section( const WaveFront_arena_t *a, int section ){
+  return a->num[section] ? a->base + arena_offset( a->cap, section ) : NULL;
+}
+
+
+#define OBJ_MIN_CHUNK_SIZE  (1 << 20)
+
+typedef struct{
+  const char *beg, *end;
+  float scale;
+  int threaded;  //parsed on a thread of its own, to be joined
+  int failed;    //the arena couldn't grow, the chunk is incomplete
+  WaveFront_arena_t arena;
+}WaveFront_chunk_t;
+
+static const char *skip_blanks( const char *ptr ){
+  while( *ptr == ' ' || *ptr == '\t' )
+    ptr++;
+  return ptr;
+}
+
+static void scan_floats( const char *ptr, float *fs, int n ){
+  for( int i = 0; i < n; i++ ){
+    char *next;
+    ptr = skip_blanks( ptr );
+    float f = strtof( ptr, &next );
+    if( next == ptr )
+      break;
+    fs[i] = f;
+    ptr = next;
+  }
+}
+
+//parses a 'v', 'v/t', 'v//n' or 'v/t/n' token in place, returns the end of the token
+static const char *scan_indices( const char *ptr, int *v, int *t, int *n ){
+  const char *tptr = NULL;
+  const char *nptr = NULL;
+  const char *p;
+
+  *v = *t = *n = -1;
+  for( p = ptr; *p != '\0' && *p != ' ' && *p != '\n'; p++ ){
+    if( '/' == *p ){
+      if( !tptr )
+        tptr = p + 1;
+      else if( !nptr )
+        nptr = p + 1;
+    }
+  }
+
+  *v = atoi( ptr ) - 1;
+  if( tptr && *tptr != '/' && tptr != p )
+    *t = atoi( tptr ) - 1;
+  if( nptr && nptr != p )
+    *n = atoi( nptr ) - 1;
+  return p;
+}
+
+static void parse_chunk( WaveFront_chunk_t *c ){
+  WaveFront_arena_t *a = &c->arena;
+  const char *line = c->beg;
+  while( line < c->end && !c->failed ){
+    const char *eol = memchr( line, '\n', c->end - line );
+    eol = eol ? eol + 1 : c->end;
+
+    if( 'v' == line[0] &&
+        ' ' == line[1] ){
+      WaveFront_vec3_t *v = arena_push( a, OBJ_VERTS );
+      if( !v )
+        break;
+      v->x = v->y = v->z = 0.0f;
+      scan_floats( &line[2], &v->x, 3 );
+      v->x *= c->scale;
+      v->y *= c->scale;
+      v->z *= c->scale;
+    }
+    else
+    if( 'v' == line[0] &&
+        'n' == line[1] ){
+      WaveFront_vec3_t *n = arena_push( a, OBJ_NORMS );
+      if( !n )
+        break;
+      n->x = n->y = n->z = 0.0f;
+      scan_floats( &line[3], &n->x, 3 );
+    }
+    else
+    if( 'v' == line[0] &&
+        't' == line[1] ){
+      WaveFront_vec2_t *t = arena_push( a, OBJ_UVS );
+      if( !t )
+        break;
+      t->x = t->y = 0.0f;
+      scan_floats( &line[3], &t->x, 2 );
+    }
+    else
+    if( 'f' == line[0] &&
+        ' ' == line[1] ){
+      WaveFront_face_t *f = arena_push( a, OBJ_FACES );
+      if( !f )
+        break;
+      const char *ptr = &line[2];
+      for( int k = 0; k < 3; k++ ){
+        ptr = skip_blanks( ptr );
+        ptr = scan_indices( ptr, &f->vs[k], &f->ts[k], &f->ns[k] );
+      }
+    }
+    line = eol;
+  }
+  c->failed = line < c->end;
+}
+
+#ifdef _WIN32
+static DWORD WINAPI parse_chunk_thread( LPVOID param ){
+  parse_chunk( param );
+  return 0;
+}
+#else
+static void *parse_chunk_thread( void *param ){
+  parse_chunk( param );
+  return NULL;
+}
+#endif
+
+static int num_cores(){
+#ifdef _WIN32
+  SYSTEM_INFO si;
+  GetSystemInfo( &si );
+  return (int)si.dwNumberOfProcessors;
+#else
+  long n = sysconf( _SC_NPROCESSORS_ONLN );
+  return n > 0 ? (int)n : 1;
+#endif
+}
+
+static int load( WaveFront_obj_t *obj, const char objfile[], float scale, int term, int num_threads, const char *caller ){
+  if( term )
+    WaveFront_obj_term( obj );
+  else
+    memset( obj, 0, sizeof(WaveFront_obj_t) );
+
+  if( scale <= 0.0f )
+    scale = 1.0f;
+
+  //the whole file is read with one call and parsed in a single pass
+  FILE *fp = fopen( objfile, "rb" );
+  if( !fp ){
+    printf( "%s - invalid OBJ file '%s'\n", caller, objfile );
+    return 0;
+  }
+  strcpy( obj->name, objfile );
+
+  fseek( fp, 0, SEEK_END );
+  size_t size = ftell( fp );
+  fseek( fp, 0, SEEK_SET );
+  char *text = malloc( size + 1 );
+  if( !text ){
+    printf( "%s - out of memory reading '%s' (%zu bytes)\n", caller, objfile, size );
+    fclose( fp );
+    return 0;
+  }
+  size = fread( text, 1, size, fp );
+  text[size] = '\0';
+  fclose( fp );
+  fp = NULL;
+
+  if( num_threads <= 0 )
+    num_threads = num_cores();
+  if( (size_t)num_threads > size / OBJ_MIN_CHUNK_SIZE )
+    num_threads = (int)( size / OBJ_MIN_CHUNK_SIZE );
+  if( num_threads < 1 )
+    num_threads = 1;
+
+  //split at line boundaries
+  WaveFront_chunk_t *chunks = calloc( num_threads, sizeof(WaveFront_chunk_t) );
+  if( !chunks ){
+    printf( "%s - out of memory splitting '%s'\n", caller, objfile );
+    free( text );
+    return 0;
+  }
+  int num_chunks = 0;
+  const char *beg = text;
+  const char *end = text + size;
+  for( int i = 1; i <= num_threads && ( beg < end || 0 == num_chunks ); i++ ){
+    const char *e = i == num_threads ? end : text + size / num_threads * i;
+    if( e < beg )
+      e = beg;
+    e = memchr( e, '\n', end - e );
+    e = e ? e + 1 : end;
+    chunks[num_chunks].beg = beg;
+    chunks[num_chunks].end = e;
+    chunks[num_chunks].scale = scale;
+    chunks[num_chunks].failed = !arena_init( &chunks[num_chunks].arena, e - beg );
+    num_chunks++;
+    beg = e;
+  }
+
+#ifdef _WIN32
+  HANDLE *threads = calloc( num_chunks, sizeof(HANDLE) );
+  for( int i = 1; threads && i < num_chunks; i++ ){
+    threads[i] = CreateThread( NULL, 0, parse_chunk_thread, &chunks[i], 0, NULL );
+    chunks[i].threaded = NULL != threads[i];
+  }
+#else
+  pthread_t *threads = calloc( num_chunks, sizeof(pthread_t) );
+  for( int i = 1; threads && i < num_chunks; i++ )
+    chunks[i].threaded = 0 == pthread_create( &threads[i], NULL, parse_chunk_thread, &chunks[i] );
+#endif
+  //the first chunk, and any whose thread couldn't be started, are parsed here
+  for( int i = 0; i < num_chunks; i++ )
+    if( !chunks[i].threaded )
+      parse_chunk( &chunks[i] );
+  for( int i = 1; i < num_chunks; i++ ){
+    if( !chunks[i].threaded )
+      continue;
+#ifdef _WIN32
+    WaitForSingleObject( threads[i], INFINITE );
+    CloseHandle( threads[i] );
+#else
+    pthread_join( threads[i], NULL );
+#endif
+  }
+  free( threads );
+  free( text );
+
+  //stitch, chunks are in file order; face indices are absolute so they carry over as is
+  int failed = 0;
+  for( int i = 0; i < num_chunks; i++ )
+    failed |= chunks[i].failed;
+  WaveFront_arena_t arena;
+  if( failed ){
+    for( int i = 0; i < num_chunks; i++ )
+      free( chunks[i].arena.base );
+  }
+  else
+  if( 1 == num_chunks ){
+    arena = chunks[0].arena;
+    arena_pack( &arena );
+  }
+  else{
+    memset( &arena, 0, sizeof(arena) );
+    for( int i = 0; i < num_chunks; i++ )
+      for( int s = 0; s < OBJ_NUM_SECTIONS; s++ )
+        arena.num[s] += chunks[i].arena.num[s];
+    memcpy( arena.cap, arena.num, sizeof(arena.cap) );
+    size_t total = arena_offset( arena.cap, OBJ_NUM_SECTIONS );
+    arena.base = total ? malloc( total ) : NULL;
+    failed = total && !arena.base;
+
+    uint32_t at[ OBJ_NUM_SECTIONS ] = { 0 };
+    for( int i = 0; i < num_chunks; i++ ){
+      WaveFront_arena_t *a = &chunks[i].arena;
+      for( int s = 0; !failed && s < OBJ_NUM_SECTIONS; s++ ){
+        if( a->num[s] )
+          memcpy( arena.base + arena_offset( arena.cap, s ) + at[s] * section_size[s],
+                  a->base + arena_offset( a->cap, s ), a->num[s] * section_size[s] );
+        at[s] += a->num[s];
+      }
+      free( a->base );
+    }
+  }
+  free( chunks );
+  if( failed ){
+    printf( "%s - out of memory parsing '%s'\n", caller, objfile );
+    return 0;
+  }
+
+  obj->arena = arena.base;
+  obj->num_verts = arena.num[ OBJ_VERTS ];
+  obj->num_uvs   = arena.num[ OBJ_UVS ];
+  obj->num_norms = arena.num[ OBJ_NORMS ];
+  obj->num_faces = arena.num[ OBJ_FACES ];
+  obj->verts = arena_section( &arena, OBJ_VERTS );
+  obj->uvs   = arena_section( &arena, OBJ_UVS );
+  obj->norms = arena_section( &arena, OBJ_NORMS );
+  obj->faces = arena_section( &arena, OBJ_FACES );
+
+  printf( "%s - OBJ '%s' loaded: %u verts, %d normals, %u tex-coords, %u faces (%d threads)\n",
+          caller,
+          obj->name,
+          obj->num_verts,
+          obj->num_norms,
+          obj->num_uvs,
+          obj->num_faces,
+          num_chunks );
+  return 1;
+}
+
+int WaveFront_obj_load( WaveFront_obj_t *obj, const char objfile[], float scale, int term ){
+  return load( obj, objfile, scale, term, 1, __FUNCTION__ );
+}
+
+int WaveFront_obj_load_mt( WaveFront_obj_t *obj, const char objfile[], float scale, int term, int num_threads ){
+  return load( obj, objfile, scale, term, num_threads, __FUNCTION__ );
+}
+
+
+void WaveFront_index_term( WaveFront_index_t *index ){
+  if( index->arena )
+    free( index->arena );
+  memset( index, 0, sizeof(WaveFront_index_t) );
+}
+
+static uint32_t hash_corner( const WaveFront_corner_t *c ){
+  uint32_t h = (uint32_t)c->v * 0x9e3779b1u;
+  h ^= (uint32_t)c->t * 0x85ebca77u + ( h >> 15 );
+  h ^= (uint32_t)c->n * 0xc2b2ae3du + ( h >> 13 );
+  return h ^ ( h >> 16 );
+}
+
+/*
+ * open addressing over corner ids, the table is at least twice the corner count so probes stay short.
+ * the corners array is sized for the worst case (nothing shared) and shrunk once the count is known
+ */
+int WaveFront_obj_index( const WaveFront_obj_t *obj, WaveFront_index_t *index ){
+  memset( index, 0, sizeof(WaveFront_index_t) );
+  uint32_t num_indices = obj->num_faces * 3;
+  if( !num_indices )
+    return 0;
+
+  uint32_t size = 16;
+  while( size < num_indices * 2 )
+    size <<= 1;
+  uint32_t mask = size - 1;
+  uint32_t *table = malloc( size * sizeof(uint32_t) );
+  size_t index_bytes = num_indices * sizeof(uint32_t);
+  char *arena = malloc( index_bytes + num_indices * sizeof(WaveFront_corner_t) );
+  if( !table || !arena ){
+    free( table );
+    free( arena );
+    return 0;
+  }
+  memset( table, 0xff, size * sizeof(uint32_t) );
+  uint32_t *indices = (uint32_t *)arena;
+  WaveFront_corner_t *corners = (WaveFront_corner_t *)( arena + index_bytes );
+  uint32_t num_corners = 0;
+
+  for( uint32_t i = 0; i < obj->num_faces; i++ ){
+    const WaveFront_face_t *f = &obj->faces[i];
+    for( int k = 0; k < 3; k++ ){
+      WaveFront_corner_t c = { f->vs[k], f->ts[k], f->ns[k] };
+      uint32_t slot = hash_corner( &c ) & mask;
+      while( 1 ){
+        uint32_t id = table[ slot ];
+        if( id == 0xffffffffu ){
+          table[ slot ] = id = num_corners;
+          corners[ num_corners++ ] = c;
+        }
+        if( corners[id].v == c.v && corners[id].t == c.t && corners[id].n == c.n ){
+          indices[ i * 3 + k ] = id;
+          break;
+        }
+        slot = ( slot + 1 ) & mask;
+      }
+    }
+  }
+  free( table );
+
+  char *packed = realloc( arena, index_bytes + num_corners * sizeof(WaveFront_corner_t) );
+  if( packed )
+    arena = packed;
+  index->arena = arena;
+  index->indices = (uint32_t *)arena;
+  index->num_indices = num_indices;
+  index->corners = (WaveFront_corner_t *)( arena + index_bytes );
+  index->num_corners = num_corners;
+
+  printf( "%s - OBJ '%s' indexed: %u corners -> %u vertices\n", __FUNCTION__, obj->name, num_indices, num_corners );
+  return 1;
+}
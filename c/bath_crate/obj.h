@@ -1,40 +1,65 @@
-#pragma once
-
-#include <stdint.h>
-
-typedef struct{
-  float x, y;
-}WaveFront_vec2_t;
-
-typedef struct{
-  float x, y, z;
-}WaveFront_vec3_t;
-
-typedef struct{
-  int   vs[3];
-  int   ts[3];
-  int   ns[3];
-}WaveFront_face_t;
-
-
-typedef struct WAVE_obj_s{
-  char name[256];
-
-  uint32_t num_verts;
-  WaveFront_vec3_t *verts;
-
-  uint32_t num_uvs;
-  WaveFront_vec2_t *uvs;
-
-  uint32_t num_norms;
-  WaveFront_vec3_t *norms;
-
-  uint32_t num_faces;
-  WaveFront_face_t *faces;
-
-}WaveFront_obj_t;
-
-
-extern void WaveFront_obj_term( WaveFront_obj_t *obj );
-extern int  WaveFront_obj_load( WaveFront_obj_t *obj, const char objfile[], float scale, int term );
-
+#pragma once
+
+#include <stdint.h>
+
+typedef struct{
+  float x, y;
+}WaveFront_vec2_t;
+
+typedef struct{
+  float x, y, z;
+}WaveFront_vec3_t;
+
+typedef struct{
+  int   vs[3];
+  int   ts[3];
+  int   ns[3];
+}WaveFront_face_t;
+
+
+typedef struct WAVE_obj_s{
+  char name[256];
+
+  uint32_t num_verts;
+  WaveFront_vec3_t *verts;
+
+  uint32_t num_uvs;
+  WaveFront_vec2_t *uvs;
+
+  uint32_t num_norms;
+  WaveFront_vec3_t *norms;
+
+  uint32_t num_faces;
+  WaveFront_face_t *faces;
+
+  //single block the four arrays above point into, released by WaveFront_obj_term
+  void *arena;
+}WaveFront_obj_t;
+
+
+//one distinct ( vertex, uv, normal ) combination used by an obj's faces, -1 where the face has none
+typedef struct{
+  int v, t, n;
+}WaveFront_corner_t;
+
+typedef struct{
+  uint32_t num_corners;
+  WaveFront_corner_t *corners;  //in first-use order
+
+  uint32_t num_indices;         //num_faces * 3, into corners
+  uint32_t *indices;
+
+  //single block both arrays point into, released by WaveFront_index_term
+  void *arena;
+}WaveFront_index_t;
+
+
+extern void WaveFront_obj_term( WaveFront_obj_t *obj );
+//returns 0, with no geometry in 'obj', if the file can't be read or memory runs out
+extern int  WaveFront_obj_load( WaveFront_obj_t *obj, const char objfile[], float scale, int term );
+//same result as WaveFront_obj_load, the file is split at line boundaries and parsed by up to 'num_threads' threads (0 = one per core)
+extern int  WaveFront_obj_load_mt( WaveFront_obj_t *obj, const char objfile[], float scale, int term, int num_threads );
+
+//collapses the faces' corners into distinct ones and the triangles into indices, for an indexed VBO
+extern int  WaveFront_obj_index( const WaveFront_obj_t *obj, WaveFront_index_t *index );
+extern void WaveFront_index_term( WaveFront_index_t *index );
@@ -0,0 +1,124 @@
+#include "vertexpack.h"
+
+#include <math.h>
+#include <string.h>
+
+static uint16_t quantize_unorm16( float v ){
+  v = v < 0.0f ? 0.0f : v > 1.0f ? 1.0f : v;
+  return (uint16_t)( v * 65535.0f + 0.5f );
+}
+
+static float dequantize_unorm16( uint16_t q ){
+  return (float)q / 65535.0f;
+}
+
+static int8_t quantize_snorm8( float v ){
+  v = v < -1.0f ? -1.0f : v > 1.0f ? 1.0f : v;
+  return (int8_t)lroundf( v * 127.0f );
+}
+
+//as the shader decodes it
+static float dequantize_snorm8( int8_t q ){
+  float v = (float)q / 127.0f;
+  return v < -1.0f ? -1.0f : v;
+}
+
+//octahedral encoding (Cigolle et al. 2014)
+static void pack_octahedral( float x, float y, float z, int8_t o[2] ){
+  o[0] = o[1] = 0;
+  float l1 = fabsf( x ) + fabsf( y ) + fabsf( z );
+  if( l1 <= 0.0f )
+    return;
+  x /= l1;
+  y /= l1;
+  if( z < 0.0f ){
+    float ox = ( 1.0f - fabsf( y ) ) * ( x >= 0.0f ? 1.0f : -1.0f );
+    float oy = ( 1.0f - fabsf( x ) ) * ( y >= 0.0f ? 1.0f : -1.0f );
+    x = ox;
+    y = oy;
+  }
+  o[0] = quantize_snorm8( x );
+  o[1] = quantize_snorm8( y );
+}
+
+static void unpack_octahedral( const int8_t o[2], float n[3] ){
+  n[0] = dequantize_snorm8( o[0] );
+  n[1] = dequantize_snorm8( o[1] );
+  n[2] = 1.0f - fabsf( n[0] ) - fabsf( n[1] );
+  float t = n[2] < 0.0f ? -n[2] : 0.0f;
+  n[0] += n[0] >= 0.0f ? -t : t;
+  n[1] += n[1] >= 0.0f ? -t : t;
+  float l = sqrtf( n[0] * n[0] + n[1] * n[1] + n[2] * n[2] );
+  for( int i = 0; i < 3; i++ )
+    n[i] /= l;
+}
+
+static float word( uint32_t lo, uint32_t hi ){
+  return (float)( lo | hi << 16 );
+}
+
+void vertex_packer_init( vertex_packer_t *vp ){
+  memset( vp, 0, sizeof(vertex_packer_t) );
+}
+
+void vertex_packer_bound( vertex_packer_t *vp, const float *p ){
+  for( int i = 0; i < 3; i++ ){
+    if( !vp->bounded || p[i] < vp->min[i] )
+      vp->min[i] = p[i];
+    if( !vp->bounded || p[i] > vp->max[i] )
+      vp->max[i] = p[i];
+  }
+  vp->bounded = 1;
+}
+
+void vertex_packer_bound_uv( vertex_packer_t *vp, const float *t ){
+  for( int i = 0; i < 2; i++ ){
+    if( !vp->t_bounded || t[i] < vp->t_min[i] )
+      vp->t_min[i] = t[i];
+    if( !vp->t_bounded || t[i] > vp->t_max[i] )
+      vp->t_max[i] = t[i];
+  }
+  vp->t_bounded = 1;
+}
+
+vertex_packed_t vertex_pack( vertex_packer_t *vp, const float *p, const float *n, const float *t ){
+  uint16_t q[3];
+  for( int i = 0; i < 3; i++ ){
+    float ext = vp->max[i] - vp->min[i];
+    q[i] = quantize_unorm16( ext > 0.0f ? ( p[i] - vp->min[i] ) / ext : 0.0f );
+    float e = fabsf( vp->min[i] + dequantize_unorm16( q[i] ) * ext - p[i] );
+    if( e > vp->max_pos_error )
+      vp->max_pos_error = e;
+  }
+
+  int8_t o[2] = { 0, 0 };
+  if( n ){
+    float l = sqrtf( n[0] * n[0] + n[1] * n[1] + n[2] * n[2] );
+    pack_octahedral( n[0], n[1], n[2], o );
+    if( l > 0.0f ){
+      float d[3];
+      unpack_octahedral( o, d );
+      float c = ( d[0] * n[0] + d[1] * n[1] + d[2] * n[2] ) / l;
+      c = c > 1.0f ? 1.0f : c < -1.0f ? -1.0f : c;
+      float e = acosf( c ) * 57.2957795f;
+      if( e > vp->max_normal_error )
+        vp->max_normal_error = e;
+    }
+  }
+
+  uint16_t uv[2] = { 0, 0 };
+  for( int i = 0; t && i < 2; i++ ){
+    float ext = vp->t_max[i] - vp->t_min[i];
+    uv[i] = quantize_unorm16( ext > 0.0f ? ( t[i] - vp->t_min[i] ) / ext : 0.0f );
+    float e = fabsf( vp->t_min[i] + dequantize_unorm16( uv[i] ) * ext - t[i] );
+    if( e > vp->max_uv_error )
+      vp->max_uv_error = e;
+  }
+
+  vertex_packed_t pv;
+  pv.w[0] = word( q[0], q[2] & 0xff );
+  pv.w[1] = word( q[1], q[2] >> 8 );
+  pv.w[2] = word( uv[0], (uint32_t)( o[0] + 128 ) );
+  pv.w[3] = word( uv[1], (uint32_t)( o[1] + 128 ) );
+  return pv;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <stdint.h>
+
+//16 byte quantized vertex: 16-bit positions relative to the mesh bounds, 16-bit uvs relative to the uv bounds
+//and an 8:8 octahedral normal. MyGL's vertex attributes are floats, so the integers are carried as float
+//values, two per word: lo + hi * 65536 stays below 2^24 and every float up there is exact. the shader splits
+//them with floor(), see VTX_PACKED in assets/shaders/includes.glsl. w[0] = x | z & 0xff, w[1] = y | z >> 8,
+//w[2] = u | normal x, w[3] = v | normal y, the normal as snorm8 + 128
+typedef struct{
+  float w[4];
+}vertex_packed_t;
+
+typedef struct{
+  float min[3], max[3];     //dequantization: p = min + unorm * ( max - min )
+  int   bounded;
+  float t_min[2], t_max[2]; //and uv = t_min + unorm * ( t_max - t_min )
+  int   t_bounded;
+
+  //largest round trip errors seen by vertex_pack(), in mesh units, uv units and degrees
+  float max_pos_error;
+  float max_uv_error;
+  float max_normal_error;
+}vertex_packer_t;
+
+
+extern void vertex_packer_init( vertex_packer_t *vp );
+//grows the bounds by 'p', call for every position before the first vertex_pack()
+extern void vertex_packer_bound( vertex_packer_t *vp, const float *p );
+//grows the uv bounds by 't', call for every uv before the first vertex_pack(); tiled uvs keep their range
+extern void vertex_packer_bound_uv( vertex_packer_t *vp, const float *t );
+//'n' and 't' may be NULL
+extern vertex_packed_t vertex_pack( vertex_packer_t *vp, const float *p, const float *n, const float *t );
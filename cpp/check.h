@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdio>
+
+// the checks the demos' tests share. each test is one file whose main() returns non-zero when a check fails,
+// built and run from its demo's directory:
+//   cpp/model_export: g++ -std=c++17 $(ls *.cpp | grep -v main.cpp) -o weld_test && ./weld_test
+//   cpp/model_loader: g++ -std=c++17 clips_test.cpp -o clips_test && ./clips_test
+namespace test {
+
+inline int failures = 0;
+
+inline void check(bool ok, const char *what) {
+  printf("%s: %s\n", ok ? "ok" : "FAILED", what);
+  failures += ok ? 0 : 1;
+}
+
+// main()'s return value
+inline int summary() {
+  printf("%d failure(s)\n", failures);
+  return failures ? 1 : 0;
+}
+
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <mygl/public/mygl.h>
+
+// vertex layouts checked at compile time: a vertex struct is described once, its members in attribute
+// order, and the MyGL_VertexAttrib array, stride and offsets all come from that, e.g.
+//
+//   struct Vertex { MyGL_Vec3 p; MyGL_Vec2 t; };
+//   VERTEX_LAYOUT(Vertex, p, t);
+//   vertexlayout::createVbo("crate", vertices);  // one memcpy into the stream
+//
+// MyGL packs attributes back to back, so the struct must too: any padding, or a member left out of the
+// layout, fails to compile instead of shearing the vertices on screen
+namespace vertexlayout {
+
+// attribute format of a member type, specialize it for anything else that goes into a VBO
+template<typename T>
+struct Format;
+
+template<>
+struct Format<float> {
+  static constexpr auto type = MYGL_VERTEX_FLOAT;
+  static constexpr auto components = MYGL_X;
+};
+
+template<>
+struct Format<MyGL_Vec2> {
+  static constexpr auto type = MYGL_VERTEX_FLOAT;
+  static constexpr auto components = MYGL_XY;
+};
+
+template<>
+struct Format<MyGL_Vec3> {
+  static constexpr auto type = MYGL_VERTEX_FLOAT;
+  static constexpr auto components = MYGL_XYZ;
+};
+
+template<>
+struct Format<MyGL_Vec4> {
+  static constexpr auto type = MYGL_VERTEX_FLOAT;
+  static constexpr auto components = MYGL_XYZW;
+};
+
+template<typename Vertex, typename ... Members>
+struct Attribs {
+  static constexpr uint32_t count = sizeof...(Members);
+  static constexpr size_t sizes[] = { sizeof(Members)... };
+  static constexpr size_t stride = (sizeof(Members) + ...);
+  static constexpr MyGL_VertexAttrib attribs[] = { { Format<Members>::type, Format<Members>::components, GL_FALSE }... };
+
+  static_assert(sizeof(Vertex) == stride, "the vertex has padding or members its layout doesn't list");
+
+  static constexpr bool packed(const size_t (&offsets)[sizeof...(Members)]) {
+    size_t offset = 0;
+    for (size_t i = 0; i < count; i++) {
+      if (offsets[i] != offset)
+        return false;
+      offset += sizes[i];
+    }
+    return true;
+  }
+};
+
+// specialized by VERTEX_LAYOUT
+template<typename Vertex>
+struct Layout;
+
+// creates the VBO 'name' with the vertex's layout and fills it with a single copy
+template<typename Vertex>
+void createVbo(const char *name, const Vertex *vertices, size_t count) {
+  using L = Layout<Vertex>;
+  MyGL_VertexAttrib attribs[L::count];
+  memcpy(attribs, L::attribs, sizeof(attribs));
+  MyGL_createVbo(name, (uint32_t) count, attribs, L::count);
+  memcpy(MyGL_vboStream(name).data, vertices, count * sizeof(Vertex));
+  MyGL_vboPush(name);
+}
+
+template<typename Vertex>
+void createVbo(const char *name, const std::vector<Vertex> &vertices) {
+  createVbo(name, vertices.data(), vertices.size());
+}
+
+}
+
+#define VERTEX_LAYOUT_TYPE(Vertex, member) decltype(Vertex::member)
+#define VERTEX_LAYOUT_OFFSET(Vertex, member) offsetof(Vertex, member)
+#define VERTEX_LAYOUT_MAP1(f, V, a) f(V, a)
+#define VERTEX_LAYOUT_MAP2(f, V, a, b) f(V, a), f(V, b)
+#define VERTEX_LAYOUT_MAP3(f, V, a, b, c) f(V, a), f(V, b), f(V, c)
+#define VERTEX_LAYOUT_MAP4(f, V, a, b, c, d) f(V, a), f(V, b), f(V, c), f(V, d)
+#define VERTEX_LAYOUT_PICK(_1, _2, _3, _4, map, ...) map
+#define VERTEX_LAYOUT_MAP(f, V, ...) \
+  VERTEX_LAYOUT_PICK(__VA_ARGS__, VERTEX_LAYOUT_MAP4, VERTEX_LAYOUT_MAP3, VERTEX_LAYOUT_MAP2, VERTEX_LAYOUT_MAP1, )(f, V, __VA_ARGS__)
+
+// up to four members, in attribute order; at global scope
+#define VERTEX_LAYOUT(Vertex, ...) \
+  template<> \
+  struct vertexlayout::Layout<Vertex> \
+      : vertexlayout::Attribs<Vertex, VERTEX_LAYOUT_MAP(VERTEX_LAYOUT_TYPE, Vertex, __VA_ARGS__)> { \
+  }; \
+  static_assert(vertexlayout::Layout<Vertex>::packed({ VERTEX_LAYOUT_MAP(VERTEX_LAYOUT_OFFSET, Vertex, __VA_ARGS__) }), \
+                #Vertex " members are not back to back in layout order")
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <vector>
+#include <cstring>
+
+#include "defs.h"
+
+// index format tag, the value is the size of one index in bytes
+enum IndexFormat : uint32 {
+  INDEX_UINT16 = 2,
+  INDEX_UINT32 = 4,
+};
+
+// triangle indices packed as 16-bit while every vertex id fits, the whole buffer is widened
+// to 32-bit the first time one doesn't; ids are never truncated
+struct IndexBuffer {
+  IndexFormat format = INDEX_UINT16;
+  size_t count = 0;
+  std::vector<uint8> data;
+
+  static IndexFormat formatFor(size_t numVertices) {
+    return numVertices <= 0x10000 ? INDEX_UINT16 : INDEX_UINT32;
+  }
+
+  void clear() {
+    format = INDEX_UINT16;
+    count = 0;
+    data.clear();
+  }
+
+  void reserve(size_t numIndices) {
+    data.reserve(numIndices * format);
+  }
+
+  size_t size() const {
+    return count;
+  }
+
+  size_t bytes() const {
+    return count * format;
+  }
+
+  const uint16* u16() const {
+    return INDEX_UINT16 == format ? (const uint16*) data.data() : nullptr;
+  }
+
+  const uint32* u32() const {
+    return INDEX_UINT32 == format ? (const uint32*) data.data() : nullptr;
+  }
+
+  uint32 operator [](size_t i) const {
+    return INDEX_UINT16 == format ? ((const uint16*) data.data())[i] : ((const uint32*) data.data())[i];
+  }
+
+  void push_back(uint32 index) {
+    if (INDEX_UINT16 == format && index > 0xffff)
+      widen();
+    data.resize(data.size() + format);
+    if (INDEX_UINT16 == format)
+      ((uint16*) data.data())[count++] = (uint16) index;
+    else
+      ((uint32*) data.data())[count++] = index;
+  }
+
+  void widen() {
+    if (INDEX_UINT32 == format)
+      return;
+    std::vector<uint8> wide(count * sizeof(uint32));
+    wide.reserve(data.capacity() * 2);
+    for (size_t i = 0; i < count; i++)
+      ((uint32*) wide.data())[i] = ((const uint16*) data.data())[i];
+    data.swap(wide);
+    format = INDEX_UINT32;
+  }
+
+  // copies the indices into a 32-bit destination (e.g. an IBO stream)
+  void copyTo(uint32 *dst) const {
+    if (INDEX_UINT32 == format) {
+      memcpy(dst, data.data(), count * sizeof(uint32));
+      return;
+    }
+    const uint16 *src = (const uint16*) data.data();
+    for (size_t i = 0; i < count; i++)
+      dst[i] = src[i];
+  }
+};
@@ -0,0 +1,53 @@
+#include "keyframes.h"
+
+namespace keyframes {
+
+namespace {
+
+// whether frame j is within maxError of the blend of frames a and b
+bool reproduced(const std::vector<std::vector<Vector3>> &frames, const std::vector<float> &times, size_t a,
+                size_t b, size_t j, float maxError) {
+  const float s = (times[j] - times[a]) / (times[b] - times[a]);
+  const float maxError2 = maxError * maxError;
+  const Vector3 *pa = frames[a].data(), *pb = frames[b].data(), *pj = frames[j].data();
+  for (size_t v = 0; v < frames[j].size(); v++) {
+    float e2 = 0.0f;
+    for (int k = 0; k < 3; k++) {
+      float e = pa[v].xyz[k] + (pb[v].xyz[k] - pa[v].xyz[k]) * s - pj[v].xyz[k];
+      e2 += e * e;
+    }
+    if (e2 > maxError2)
+      return false;
+  }
+  return true;
+}
+
+}
+
+std::vector<uint32> reduce(const std::vector<std::vector<Vector3>> &frames, const std::vector<float> &times,
+                           float maxError) {
+  std::vector<uint32> kept;
+  const size_t n = frames.size();
+  if (!n)
+    return kept;
+
+  kept.push_back(0);
+  size_t a = 0;
+  while (a + 1 < n) {
+    // extend the span a..b while everything inside it still blends back within the error
+    size_t b = a + 1;
+    while (b + 1 < n) {
+      bool fits = true;
+      for (size_t j = a + 1; j <= b && fits; j++)
+        fits = reproduced(frames, times, a, b + 1, j, maxError);
+      if (!fits)
+        break;
+      b++;
+    }
+    kept.push_back((uint32) b);
+    a = b;
+  }
+  return kept;
+}
+
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "defs.h"
+#include "myvector.h"
+
+// keyframe reduction for vertex animation
+namespace keyframes {
+
+// the frames to keep, in order and always the first and the last: every dropped frame is reproduced within
+// 'maxError' model units, at every vertex, by blending the kept frames around it linearly by time.
+// frames[f][v] is the position of vertex v in frame f at times[f], which increase. greedy, each kept frame
+// spans as many frames as it can, so a maxError of 0 still drops frames that are exactly in between
+std::vector<uint32> reduce(const std::vector<std::vector<Vector3>> &frames, const std::vector<float> &times,
+                           float maxError);
+
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <thread>
+#include <vector>
+#include <utility>
+#include <cstring>
+
+#include "defs.h"
+
+// splits [begin, end) into at most 'numChunks' ranges, each at least 'minChunkSize' bytes long,
+// that start and end on line boundaries; chunks are in file order
+inline std::vector<std::pair<const char*, const char*>> splitLines(const char *begin, const char *end, uint32 numChunks,
+                                                                   size_t minChunkSize = 1 << 20) {
+  if (0 == numChunks) {
+    numChunks = std::thread::hardware_concurrency();
+    numChunks = numChunks ? numChunks : 1;
+  }
+  size_t size = (size_t) (end - begin);
+  if (minChunkSize && size / minChunkSize < numChunks)
+    numChunks = (uint32) (size / minChunkSize);
+  numChunks = numChunks ? numChunks : 1;
+
+  std::vector<std::pair<const char*, const char*>> chunks;
+  const char *p = begin;
+  for (uint32 i = 1; i <= numChunks && p < end; i++) {
+    const char *q = i == numChunks ? end : begin + size / numChunks * i;
+    if (q < p)
+      q = p;
+    const void *nl = memchr(q, '\n', end - q);
+    q = nl ? (const char*) nl + 1 : end;
+    chunks.push_back( { p, q });
+    p = q;
+  }
+  if (chunks.empty())
+    chunks.push_back( { begin, end });
+  return chunks;
+}
+
+// runs fn(chunkNo, begin, end) for every chunk, one thread per chunk (the first chunk runs on the calling thread)
+template<typename Fn>
+void forEachChunk(const std::vector<std::pair<const char*, const char*>> &chunks, Fn fn) {
+  std::vector<std::thread> workers;
+  for (size_t i = 1; i < chunks.size(); i++)
+    workers.emplace_back(fn, i, chunks[i].first, chunks[i].second);
+  if (chunks.size())
+    fn(size_t(0), chunks[0].first, chunks[0].second);
+  for (auto &w : workers)
+    w.join();
+}
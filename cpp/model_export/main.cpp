@@ -1,130 +1,304 @@
-#include <cstdio>
-#include <cstdlib>
-#include <cstdarg>
-#include <cstring>
-#define _USE_MATH_DEFINES
-#include <cmath>
-#include <string>
-#include <sstream>
-#include <vector>
-#include <set>
-
-#include "obj.h"
-#include "filedata.h"
-
-using namespace wavefront;
-
-
-const std::string_view name = "doomguy";
-const std::string_view loadDir = "assets/doomguy";
-const std::string_view exportDir = "export/doomguy";
-
-// used by both export routines
-std::vector<Vertex> verts;
-
-std::string objFrameFileName(size_t frameNo) {
-  char token[256];
-  sprintf(token, "%s/%s_%.6zu.obj", loadDir.data(), name.data(), frameNo);
-  return token;
-}
-
-void exportBaseFromOBJ(const SimpleObj &obj) {
-  struct Tri {
-    int i, j, k;
-  };
-
-  std::vector<Tri> tris;
-
-  std::set<Vertex> vertSet;
-  for (auto face : obj.faces) {
-    vertSet.insert(face.v0);
-    vertSet.insert(face.v1);
-    vertSet.insert(face.v2);
-  }
-
-  verts.clear();
-  for (auto v : vertSet)
-    verts.push_back(v);
-
-  auto getIndex = [&](Vertex v) -> int {
-    size_t l = 0;
-    size_t r = verts.size() - 1;
-    while (l <= r) {
-      size_t m = (l + r) / 2;
-      if (verts[m] < v)
-        l = m + 1;
-      else if (verts[m] > v)
-        r = m - 1;
-      else
-        return (int) m;
-    }
-    return -1;
-  };
-
-  tris.clear();
-  for (auto face : obj.faces) {
-    Tri tri;
-    tri.i = getIndex(face.v0);
-    tri.j = getIndex(face.v1);
-    tri.k = getIndex(face.v2);
-    tris.push_back(tri);
-  }
-
-  printf("%s results:\n", __FUNCTION__);
-  printf(" * no. of vertices.: %zu\n", verts.size());
-  printf(" * no. of triangles: %zu\n", tris.size());
-
-  std::stringstream ss;
-  ss << exportDir << "/mesh.txt";
-
-  FILE *fp = fopen(ss.str().c_str(), "w");
-  for (auto v : verts) {
-    fprintf(fp, "v ");
-    fprintf(fp, "%f,%f,%f %f,%f,%f %f,%f\n", obj.coords[v.vp].x,
-            obj.coords[v.vp].y, obj.coords[v.vp].z, obj.nos[v.vn].x,
-            obj.nos[v.vn].y, obj.nos[v.vn].z, obj.uvs[v.vt].x, obj.uvs[v.vt].y);
-  }
-  for (auto t : tris) {
-    fprintf(fp, "f %d,%d,%d\n", t.i, t.j, t.k);
-  }
-  fclose(fp);
-
-}
-
-void exportFrameFromObj(const SimpleObj &obj, int frameNo) {
-  if (frameNo <= 0)
-    return;
-
-  std::stringstream ss;
-  ss << exportDir;
-  ss << "/";
-  ss << "frame_";
-  ss << frameNo;
-  ss << ".txt";
-
-  FILE *fp = fopen(ss.str().c_str(), "w");
-  for (auto v : verts) {
-    fprintf(fp, "v %f,%f,%f %f,%f,%f\n", obj.coords[v.vp].x, obj.coords[v.vp].y,
-            obj.coords[v.vp].z, obj.nos[v.vn].x, obj.nos[v.vn].y,
-            obj.nos[v.vn].z);
-  }
-  fclose(fp);
-  printf("frame '%s' created\n", ss.str().c_str());
-}
-
-int main() {
-  printf("hello world!\n");
-  SimpleObj obj;
-  obj.loadFromFile(loadDir, name, 0);
-
-  exportBaseFromOBJ(obj);
-  for (size_t i = 1; i < 256; i++) {
-    if (!FileData::exists(objFrameFileName(i)))
-      break;
-    obj.loadFromFile(loadDir, name, i);
-    exportFrameFromObj(obj, i);
-  }
-
-  printf("goodbye!\n");
-  return 0;
-}
+#include <cstdio>
+#include <cstdlib>
+#include <cstdarg>
+#include <cstring>
+#define _USE_MATH_DEFINES
+#include <cmath>
+#include <string>
+#include <sstream>
+#include <vector>
+
+#include "obj.h"
+#include "filedata.h"
+#include "vertexindexer.h"
+#include "weld.h"
+#include "vertexcache.h"
+#include "simplify.h"
+#include "streamexport.h"
+#include "vertexanim.h"
+#include "keyframes.h"
+#include "pca.h"
+#include "vertexbasis.h"
+
+using namespace wavefront;
+
+
+const std::string_view name = "doomguy";
+const std::string_view loadDir = "assets/doomguy";
+const std::string_view exportDir = "export/doomguy";
+// vertices whose positions are this many model units apart and whose normals and uvs are equal are merged,
+// unless some frame moves them apart; 0 merges only exact duplicates
+const float weldEpsilon = 1e-5f;
+// reorder the exported mesh for the vertex cache, overdraw and vertex fetch
+const bool optimizeMesh = true;
+// triangle ratios of mesh_lod1.txt, mesh_lod2.txt, ...; the vertices each LOD uses are a prefix of mesh.txt,
+// so the frames serve every LOD
+const std::vector<float> lodRatios = { 0.5f, 0.25f, 0.125f };
+// frames that the blend of the keyframes around them reproduces within this many model units are dropped
+const float keyframeError = 0.01f;
+// frames.pca rebuilds every frame within this many model units; it's only written when it beats frames.bin
+const float basisError = 0.01f;
+
+// used by both export routines
+std::vector<Vertex> verts;
+
+std::string objFrameFileName(size_t frameNo) {
+  char token[256];
+  sprintf(token, "%s/%s_%.6zu.obj", loadDir.data(), name.data(), frameNo);
+  return token;
+}
+
+void exportLod(const SimpleObj &obj, const simplify::Lod &lod, size_t lodNo) {
+  std::stringstream ss;
+  ss << exportDir << "/mesh_lod" << lodNo << ".txt";
+
+  // same layout as mesh.txt plus the geometric error, for picking a LOD by its error on screen
+  FILE *fp = fopen(ss.str().c_str(), "w");
+  fprintf(fp, "e %f\n", lod.error);
+  for (uint32 i = 0; i < lod.numVertices; i++) {
+    const auto &v = verts[i];
+    fprintf(fp, "v %f,%f,%f %f,%f,%f %f,%f\n", obj.coords[v.vp].x, obj.coords[v.vp].y, obj.coords[v.vp].z,
+            obj.nos[v.vn].x, obj.nos[v.vn].y, obj.nos[v.vn].z, obj.uvs[v.vt].x, obj.uvs[v.vt].y);
+  }
+  for (size_t i = 0; i < lod.indices.size(); i += 3)
+    fprintf(fp, "f %u,%u,%u\n", lod.indices[i], lod.indices[i + 1], lod.indices[i + 2]);
+  fclose(fp);
+}
+
+// indexes the base's corners into 'verts' and welds them, reading the frames one at a time: each is only
+// held until its twins are checked and its positions are kept in frameCoords[f][vp]. returns the number of
+// vertices merged away
+uint32 indexBaseAndFrames(const SimpleObj &obj, std::vector<uint32> &indices,
+                          std::vector<std::vector<Vector3>> &frameCoords) {
+  // one pass: every corner gets its unique vertex id as it's visited
+  VertexIndexer indexer;
+  indexer.reserve(obj.faces.size() * 3);
+  indices.reserve(obj.faces.size() * 3);
+  for (const auto &face : obj.faces) {
+    indices.push_back(indexer.index(face.v0.vp, face.v0.vn, face.v0.vt));
+    indices.push_back(indexer.index(face.v1.vp, face.v1.vn, face.v1.vt));
+    indices.push_back(indexer.index(face.v2.vp, face.v2.vn, face.v2.vt));
+  }
+
+  verts.clear();
+  verts.reserve(indexer.size());
+  for (const auto &key : indexer.keys)
+    verts.push_back(Vertex(key.vp, key.vn, key.vt));
+
+  // frames only bring positions and normals, the faces must be the base's
+  auto into = weld::twins(obj, weldEpsilon, 0.0f, verts);
+  frameCoords.clear();
+  SimpleObj frame;
+  for (size_t i = 1; i < 256; i++) {
+    if (!FileData::exists(objFrameFileName(i)) || !frame.loadFrame(loadDir, name, i, obj))
+      break;
+    weld::split(obj, frame, weldEpsilon, 0.0f, verts, into);
+    frameCoords.push_back(std::move(frame.coords));
+  }
+  return weld::merge(into, verts, indices);
+}
+
+void exportBaseFromOBJ(const SimpleObj &obj, const std::vector<std::vector<Vector3>> &frameCoords,
+                       std::vector<uint32> &indices, uint32 numWelded) {
+  printf("%s results:\n", __FUNCTION__);
+  printf(" * welded..........: %u vertices (epsilon %g)\n", numWelded, weldEpsilon);
+  printf(" * no. of vertices.: %zu\n", verts.size());
+  printf(" * no. of triangles: %zu\n", indices.size() / 3);
+
+  if (optimizeMesh) {
+    // triangles for the post-transform cache, then clusters of them for overdraw, then the vertices
+    // in fetch order; 'verts' is reordered too, so the frames follow the new order
+    float before = vertexcache::acmr(indices, verts.size());
+    std::vector<uint32> clusters;
+    vertexcache::optimizeVertexCache(indices, verts.size(), 16, &clusters);
+    float afterCache = vertexcache::acmr(indices, verts.size());
+
+    std::vector<Vector3> positions;
+    positions.reserve(verts.size());
+    for (const auto &v : verts)
+      positions.push_back(obj.coords[v.vp]);
+    vertexcache::optimizeOverdraw(indices, positions, clusters);
+    float afterOverdraw = vertexcache::acmr(indices, verts.size());
+
+    auto remap = vertexcache::optimizeVertexFetch(indices, verts.size());
+    std::vector<Vertex> fetchOrder(verts.size());
+    size_t numUsed = 0;
+    for (size_t i = 0; i < verts.size(); i++) {
+      if (remap[i] != ~0u) {
+        fetchOrder[remap[i]] = verts[i];
+        numUsed++;
+      }
+    }
+    fetchOrder.resize(numUsed);
+    verts.swap(fetchOrder);
+
+    printf(" * ACMR (FIFO 16)..: %.3f -> %.3f (vertex cache) -> %.3f (overdraw, %zu clusters)\n", before, afterCache,
+           afterOverdraw, clusters.size());
+  }
+
+  std::vector<simplify::Lod> lods;
+  if (lodRatios.size()) {
+    // simplified against the base and every frame; vertices sharing an OBJ position are seam twins, and
+    // the positions are looked up by it
+    std::vector<uint32> groups;
+    groups.reserve(verts.size());
+    for (const auto &v : verts)
+      groups.push_back(v.vp);
+    lods = simplify::buildLods(indices, obj.coords, frameCoords, groups, lodRatios);
+    if (optimizeMesh)
+      for (auto &lod : lods)
+        vertexcache::optimizeVertexCache(lod.indices, verts.size(), 16, nullptr);
+
+    auto remap = simplify::orderVerticesForLods(indices, lods, verts.size());
+    std::vector<Vertex> lodOrder(verts.size());
+    for (size_t i = 0; i < verts.size(); i++)
+      lodOrder[remap[i]] = verts[i];
+    verts.swap(lodOrder);
+
+    for (size_t i = 0; i < lods.size(); i++)
+      printf(" * LOD %zu (%.3f)...: %zu triangles, %u vertices, error %f\n", i + 1, lods[i].ratio,
+             lods[i].indices.size() / 3, lods[i].numVertices, lods[i].error);
+  }
+
+  std::stringstream ss;
+  ss << exportDir << "/mesh.txt";
+
+  FILE *fp = fopen(ss.str().c_str(), "w");
+  for (auto v : verts) {
+    fprintf(fp, "v ");
+    fprintf(fp, "%f,%f,%f %f,%f,%f %f,%f\n", obj.coords[v.vp].x,
+            obj.coords[v.vp].y, obj.coords[v.vp].z, obj.nos[v.vn].x,
+            obj.nos[v.vn].y, obj.nos[v.vn].z, obj.uvs[v.vt].x, obj.uvs[v.vt].y);
+  }
+  for (size_t i = 0; i < indices.size(); i += 3) {
+    fprintf(fp, "f %u,%u,%u\n", indices[i], indices[i + 1], indices[i + 2]);
+  }
+  fclose(fp);
+
+  for (size_t i = 0; i < lods.size(); i++)
+    exportLod(obj, lods[i], i + 1);
+}
+
+void exportFrameFromObj(const SimpleObj &obj, int frameNo) {
+  if (frameNo <= 0)
+    return;
+
+  std::stringstream ss;
+  ss << exportDir;
+  ss << "/";
+  ss << "frame_";
+  ss << frameNo;
+  ss << ".txt";
+
+  FILE *fp = fopen(ss.str().c_str(), "w");
+  for (auto v : verts) {
+    fprintf(fp, "v %f,%f,%f %f,%f,%f\n", obj.coords[v.vp].x, obj.coords[v.vp].y,
+            obj.coords[v.vp].z, obj.nos[v.vn].x, obj.nos[v.vn].y,
+            obj.nos[v.vn].z);
+  }
+  fclose(fp);
+  printf("frame '%s' created\n", ss.str().c_str());
+}
+
+// the frames' positions in 'verts' order, each frame's coords are released once they're copied; the times
+// are the frames' numbers
+void framePositions(std::vector<std::vector<Vector3>> &frameCoords, std::vector<std::vector<Vector3>> &positions,
+                    std::vector<float> &times) {
+  positions.assign(frameCoords.size(), {});
+  times.clear();
+  for (size_t f = 0; f < frameCoords.size(); f++) {
+    positions[f].reserve(verts.size());
+    for (auto v : verts)
+      positions[f].push_back(frameCoords[f][v.vp]);
+    std::vector<Vector3>().swap(frameCoords[f]);
+    times.push_back((float) (f + 1));
+  }
+}
+
+// the frames reduced to keyframes and quantized into one file for model_loader to map. returns the kept
+// frames
+std::vector<uint32> exportAnimation(const std::vector<std::vector<Vector3>> &positions,
+                                    const std::vector<float> &times) {
+  if (positions.empty())
+    return {};
+
+  auto kept = keyframes::reduce(positions, times, keyframeError);
+
+  std::vector<float> keyPositions;
+  std::vector<float> keyTimes;
+  keyPositions.reserve(kept.size() * verts.size() * 3);
+  for (uint32 f : kept) {
+    for (const auto &p : positions[f])
+      keyPositions.insert(keyPositions.end(), p.xyz, p.xyz + 3);
+    keyTimes.push_back(times[f]);
+  }
+
+  std::stringstream ss;
+  ss << exportDir << "/frames.bin";
+  if (vertexanim::write(ss.str().c_str(), keyPositions.data(), keyTimes.data(), (uint32) kept.size(),
+                        (uint32) verts.size()))
+    printf("animation '%s' created: %zu of %zu frames kept, %zu bytes\n", ss.str().c_str(), kept.size(),
+           positions.size(), vertexanim::fileSize((uint32) kept.size(), (uint32) verts.size()));
+  return kept;
+}
+
+// every frame as a mean shape plus a few bases, see vertexbasis.h. long clips shrink to a handful of frames'
+// worth; short ones don't, so the file is only kept when it's smaller than 'keyframes' frames of frames.bin
+void exportBasis(const std::vector<std::vector<Vector3>> &positions, const std::vector<float> &times,
+                 size_t keyframes) {
+  std::stringstream ss;
+  ss << exportDir << "/frames.pca";
+  remove(ss.str().c_str());
+  if (positions.size() < 2)
+    return;
+
+  auto basis = pca::compress(positions, basisError);
+  size_t size = vertexbasis::fileSize((uint32) positions.size(), basis.numVertices, basis.numBases);
+  size_t binSize = vertexanim::fileSize((uint32) keyframes, (uint32) verts.size());
+  if (size >= binSize) {
+    printf("basis skipped: %u bases, %zu bytes against %zu for the keyframes\n", basis.numBases, size, binSize);
+    return;
+  }
+
+  vertexbasis::Header header = { vertexbasis::magic, vertexbasis::version, (uint32) positions.size(),
+                                 basis.numVertices, basis.numBases, basis.error };
+  if (vertexbasis::write(ss.str().c_str(), header, times.data(), basis.mean.data(), basis.bases.data(),
+                         basis.coefficients.data()))
+    printf("basis '%s' created: %u bases, error %f, %zu bytes\n", ss.str().c_str(), basis.numBases, basis.error,
+           size);
+}
+
+// 'model_export <in.obj> <out mesh.txt>' streams a single OBJ too big to load, see streamexport.h;
+// without arguments the model above is exported with its frames and LODs
+int main(int argc, char **argv) {
+  printf("hello world!\n");
+  if (3 == argc) {
+    bool ok = streamexport::convert(argv[1], argv[2]);
+    printf("goodbye!\n");
+    return ok ? 0 : 1;
+  }
+
+  SimpleObj obj;
+  obj.loadFromFile(loadDir, name, 0);
+
+  // the weld and the LODs are checked against every frame, so the frames are read before the base is
+  // exported; only their positions stay in memory
+  std::vector<uint32> indices;
+  std::vector<std::vector<Vector3>> frameCoords;
+  uint32 numWelded = indexBaseAndFrames(obj, indices, frameCoords);
+
+  exportBaseFromOBJ(obj, frameCoords, indices, numWelded);
+  std::vector<std::vector<Vector3>> positions;
+  std::vector<float> times;
+  framePositions(frameCoords, positions, times);
+  auto kept = exportAnimation(positions, times);
+  // the kept frames are read again for their normals
+  SimpleObj frame;
+  for (uint32 i : kept)
+    if (frame.loadFrame(loadDir, name, i + 1, obj))
+      exportFrameFromObj(frame, i + 1);
+  exportBasis(positions, times, kept.size());
+
+  printf("goodbye!\n");
+  return 0;
+}
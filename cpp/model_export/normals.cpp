@@ -0,0 +1,202 @@
+#include "normals.h"
+
+#include <cmath>
+#include <cstring>
+#include <thread>
+
+namespace normals {
+
+namespace {
+
+// runs fn(begin, end) over [0, count) split into one range per thread, the first on the calling thread
+template<typename Fn>
+void parallelFor(size_t count, uint32 numThreads, Fn fn) {
+  const size_t minPerThread = 1 << 14;
+  size_t n = numThreads;
+  n = n < 1 ? 1 : n;
+  n = count / minPerThread < n ? count / minPerThread : n;
+  n = n < 1 ? 1 : n;
+
+  std::vector<std::thread> workers;
+  for (size_t i = 1; i < n; i++)
+    workers.emplace_back(fn, count * i / n, count * (i + 1) / n);
+  fn(size_t(0), count / n);
+  for (auto &w : workers)
+    w.join();
+}
+
+// the Vector3 operators live in myvector.cpp, these loops run once per corner so they stay inline
+inline float dot(const float *a, const float *b) {
+  return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+inline void addScaled(float *sum, const float *v, float s) {
+  sum[0] += v[0] * s;
+  sum[1] += v[1] * s;
+  sum[2] += v[2] * s;
+}
+
+float cornerAngle(const float *e1, const float *e2) {
+  float l = sqrtf(dot(e1, e1) * dot(e2, e2));
+  if (l <= 0.0f)
+    return 0.0f;
+  float d = dot(e1, e2) / l;
+  return acosf(d < -1.0f ? -1.0f : d > 1.0f ? 1.0f : d);
+}
+
+Vector3 normalizedOr(const float *n, const Vector3 &fallback) {
+  float l = sqrtf(dot(n, n));
+  return l > 0.0f ? Vector3(n[0] / l, n[1] / l, n[2] / l) : fallback;
+}
+
+// unit face normal and, per corner, area x angle
+void weighTriangle(const float *p[3], Vector3 &normal, float weights[3]) {
+  float e[3][3];
+  for (int i = 0; i < 3; i++)
+    for (int k = 0; k < 3; k++)
+      e[i][k] = p[(i + 1) % 3][k] - p[i][k];  // edge from corner i to the next
+  float n[3] = { e[0][1] * e[2][2] - e[0][2] * e[2][1], e[0][2] * e[2][0] - e[0][0] * e[2][2],
+                 e[0][0] * e[2][1] - e[0][1] * e[2][0] };
+  n[0] = -n[0], n[1] = -n[1], n[2] = -n[2];   // e0 x -e2
+  float l = sqrtf(dot(n, n));
+  normal = l > 0.0f ? Vector3(n[0] / l, n[1] / l, n[2] / l) : Vector3();
+  for (int i = 0; i < 3; i++) {
+    float in[3] = { -e[(i + 2) % 3][0], -e[(i + 2) % 3][1], -e[(i + 2) % 3][2] };
+    weights[i] = 0.5f * l * cornerAngle(e[i], in);
+  }
+}
+
+}
+
+void generate(const std::vector<Vector3> &positions, const std::vector<uint32> &corners, float creaseAngle,
+              uint32 numThreads, std::vector<Vector3> &normals, std::vector<uint32> &cornerNormals) {
+  if (0 == numThreads) {
+    numThreads = std::thread::hardware_concurrency();
+    numThreads = numThreads ? numThreads : 1;
+  }
+  size_t numTris = corners.size() / 3;
+  size_t numPositions = positions.size();
+
+  std::vector<Vector3> faceNormals(numTris);
+  std::vector<float> weights(numTris * 3);
+  parallelFor(numTris, numThreads, [&](size_t begin, size_t end) {
+    for (size_t t = begin; t < end; t++) {
+      const float *p[3] = { positions[corners[t * 3]].xyz, positions[corners[t * 3 + 1]].xyz,
+                            positions[corners[t * 3 + 2]].xyz };
+      weighTriangle(p, faceNormals[t], &weights[t * 3]);
+    }
+  });
+
+  // position -> corners, compressed rows in corner order; this fixes the summation order
+  std::vector<uint32> offsets(numPositions + 1, 0);
+  for (uint32 p : corners)
+    offsets[p + 1]++;
+  for (size_t p = 1; p <= numPositions; p++)
+    offsets[p] += offsets[p - 1];
+  std::vector<uint32> incident(corners.size());
+  {
+    std::vector<uint32> next(offsets.begin(), offsets.end() - 1);
+    for (uint32 i = 0; i < corners.size(); i++)
+      incident[next[corners[i]]++] = i;
+  }
+
+  const Vector3 up(0.0f, 0.0f, 1.0f);
+  if (creaseAngle >= 180.0f) {
+    normals.resize(numPositions);
+    parallelFor(numPositions, numThreads, [&](size_t begin, size_t end) {
+      for (size_t p = begin; p < end; p++) {
+        float n[3] = { 0.0f, 0.0f, 0.0f };
+        for (uint32 i = offsets[p]; i < offsets[p + 1]; i++)
+          addScaled(n, faceNormals[incident[i] / 3].xyz, weights[incident[i]]);
+        normals[p] = normalizedOr(n, offsets[p] < offsets[p + 1] ? faceNormals[incident[offsets[p]] / 3] : up);
+      }
+    });
+    cornerNormals = corners;
+    return;
+  }
+
+  // every corner sums the faces within the crease angle of its own; corners at a position that end up
+  // with the same normal share it
+  float cosCrease = cosf(creaseAngle * (float) M_PI / 180.0f);
+  std::vector<Vector3> cornerValues(corners.size());
+  std::vector<uint32> numUnique(numPositions, 0);
+  cornerNormals.resize(corners.size());
+  parallelFor(numPositions, numThreads, [&](size_t begin, size_t end) {
+    for (size_t p = begin; p < end; p++) {
+      uint32 first = offsets[p], last = offsets[p + 1];
+      for (uint32 i = first; i < last; i++) {
+        const Vector3 &own = faceNormals[incident[i] / 3];
+        float sum[3] = { 0.0f, 0.0f, 0.0f };
+        for (uint32 j = first; j < last; j++) {
+          const float *other = faceNormals[incident[j] / 3].xyz;
+          if (dot(own.xyz, other) >= cosCrease)
+            addScaled(sum, other, weights[incident[j]]);
+        }
+        Vector3 n = normalizedOr(sum, own);
+        cornerValues[incident[i]] = n;
+
+        // local id: the first corner at this position with bitwise the same normal
+        uint32 id = numUnique[p];
+        for (uint32 j = first; j < i; j++) {
+          if (0 == memcmp(&cornerValues[incident[j]], &n, sizeof(Vector3))) {
+            id = cornerNormals[incident[j]];
+            break;
+          }
+        }
+        if (id == numUnique[p])
+          numUnique[p]++;
+        cornerNormals[incident[i]] = id;
+      }
+    }
+  });
+
+  std::vector<uint32> firstNormal(numPositions + 1, 0);
+  for (size_t p = 0; p < numPositions; p++)
+    firstNormal[p + 1] = firstNormal[p] + numUnique[p];
+  normals.resize(firstNormal[numPositions]);
+  parallelFor(numPositions, numThreads, [&](size_t begin, size_t end) {
+    for (size_t p = begin; p < end; p++) {
+      for (uint32 i = offsets[p]; i < offsets[p + 1]; i++) {
+        uint32 c = incident[i];
+        cornerNormals[c] += firstNormal[p];
+        normals[cornerNormals[c]] = cornerValues[c];
+      }
+    }
+  });
+}
+
+void Accumulator::reset(size_t numPositions) {
+  sums.assign(numPositions, Vector3());
+  fallbacks.assign(numPositions, Vector3());
+  used.assign(numPositions, 0);
+}
+
+void Accumulator::add(const std::vector<Vector3> &positions, const uint32 corners[3]) {
+  if (sums.size() < positions.size()) {
+    sums.resize(positions.size());
+    fallbacks.resize(positions.size());
+    used.resize(positions.size(), 0);
+  }
+  const float *p[3] = { positions[corners[0]].xyz, positions[corners[1]].xyz, positions[corners[2]].xyz };
+  Vector3 normal;
+  float weights[3];
+  weighTriangle(p, normal, weights);
+  for (int i = 0; i < 3; i++) {
+    uint32 c = corners[i];
+    addScaled(sums[c].xyz, normal.xyz, weights[i]);
+    if (!used[c]) {
+      fallbacks[c] = normal;
+      used[c] = 1;
+    }
+  }
+}
+
+void Accumulator::finish(std::vector<Vector3> &normals) {
+  const Vector3 up(0.0f, 0.0f, 1.0f);
+  normals.resize(sums.size());
+  for (size_t p = 0; p < sums.size(); p++)
+    normals[p] = normalizedOr(sums[p].xyz, used[p] ? fallbacks[p] : up);
+  reset(0);
+}
+
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "defs.h"
+#include "myvector.h"
+
+// vertex normals for meshes that come without any
+namespace normals {
+
+// every triangle's normal, weighted by its area and the angle at the corner, summed per position.
+// with a crease angle under 180 degrees a corner only sums the faces around its position that are within
+// that angle of its own face, so hard edges stay hard. positions[corners[i]] is corner i, three per triangle.
+// fills 'normals' and cornerNormals[i], the index of corner i's normal; without creases there is one normal
+// per position and cornerNormals equals 'corners'. every normal is summed by one thread in a fixed order,
+// so the result is the same for any numThreads (0 uses every hardware thread)
+void generate(const std::vector<Vector3> &positions, const std::vector<uint32> &corners, float creaseAngle,
+              uint32 numThreads, std::vector<Vector3> &normals, std::vector<uint32> &cornerNormals);
+
+// generate() without creases for triangles that are never all in memory at once, e.g. streamed from a file:
+// add() every triangle in order and finish() gives bitwise the same normals, in O(positions) memory.
+// 'positions' may still be growing between add() calls
+struct Accumulator {
+  std::vector<Vector3> sums;
+  std::vector<Vector3> fallbacks;  // the first face normal at each position, for sums that cancel out
+  std::vector<uint8> used;
+
+  void reset(size_t numPositions);
+  void add(const std::vector<Vector3> &positions, const uint32 corners[3]);
+  void finish(std::vector<Vector3> &normals);
+};
+
+}
@@ -1,367 +1,655 @@
-#include "obj.h"
-
-#include <sstream>
-#include <cstring>
-#include <set>
-#include <cstdarg>
-#include <sstream>
-
-namespace wavefront {
-
-void parse(Vector3 &v, const char *text) {
-  char temp[1024];
-  strcpy(temp, text);
-  v.x = (float) strtod(strtok(temp, " \n"), NULL);
-  v.y = (float) strtod(strtok( NULL, " \n"), NULL);
-  v.z = (float) strtod(strtok( NULL, " \n"), NULL);
-}
-
-void parse(Vector2 &v, const char *text) {
-  char temp[1024];
-  strcpy(temp, text);
-  v.x = (float) strtod(strtok(temp, " \n"), NULL);
-  v.y = (float) strtod(strtok( NULL, " \n"), NULL);
-}
-
-bool Vertex::operator <(const Vertex &rhs) const {
-  if (vp < rhs.vp)
-    return true;
-  else if (vp > rhs.vp)
-    return false;
-  else {
-    if (vn < rhs.vn)
-      return true;
-    else if (vn > rhs.vn)
-      return false;
-    else {
-      if (vt < rhs.vt)
-        return true;
-      else if (vt >= rhs.vt)
-        return false;
-    }
-  }
-  return false;
-}
-
-bool Vertex::operator >(const Vertex &rhs) const {
-  return rhs < *this;
-}
-
-bool Vertex::operator ==(const Vertex &rhs) const {
-  return vp == rhs.vp && vn == rhs.vn && vt == rhs.vt;
-}
-
-void Vertex::parse(const char *text) {
-  char temp[1024];
-  strcpy(temp, text);
-
-  vn = vt = -1;
-
-  int32 numSlashes = 0;
-  for (int32 i = 0; temp[i] != '\0'; i++)
-    if ('/' == temp[i])
-      numSlashes++;
-
-  if (0 == numSlashes) {
-    vp = atoi(temp) - 1;
-    return;
-  }
-
-  if (1 == numSlashes) {
-    vp = atoi(strtok(temp, "/")) - 1;
-    vn = atoi(strtok( NULL, " ")) - 1;
-    return;
-  }
-
-  if (2 == numSlashes) {
-    int32 i = 0;
-    char *toks[2];
-    for (i = 0; temp[i] != '\0'; i++)
-      if ('/' == temp[i]) {
-        temp[i] = '\0';
-        toks[0] = &temp[i + 1];
-        break;
-      }
-
-    i++;
-    for (; temp[i] != '\0'; i++)
-      if ('/' == temp[i]) {
-        temp[i] = '\0';
-        toks[1] = &temp[i + 1];
-        break;
-      }
-
-    vp = atoi(temp) - 1;
-
-    if (*toks[0] != '\0')  //int the case of 'vp//vn', where there is no 'vt'
-      vt = atoi(toks[0]) - 1;
-
-    vn = atoi(toks[1]) - 1;
-  }
-}
-
-bool SimpleObj::loadFromFile(std::string_view dir, std::string_view name, int frame) {
-  std::stringstream ss;
-  ss << dir;
-  ss << "/";
-  ss << name;
-  if (frame > 0) {
-    char buff[64];
-    sprintf(buff, "_%.6u", frame);
-    ss << std::string(buff);
-  }
-  ss << ".obj";
-  filename = ss.str();
-
-  FILE *fp = fopen(filename.c_str(), "r");
-  if (!fp) {
-    printf("%s - file '%s' not found\n", __FUNCTION__, filename.c_str());
-    filename = "";
-    return false;
-  }
-  printf("%s - loading OBJ data from file '%s'\n", __FUNCTION__, filename.c_str());
-  coords.clear();
-  nos.clear();
-  uvs.clear();
-  faces.clear();
-
-  char line[256];
-  while (fgets(line, sizeof(line), fp)) {
-
-    if ('v' == line[0] && ' ' == line[1]) {
-      Vector3 v;
-      parse(v, &line[2]);
-      coords.push_back(v);
-    }
-
-    if ('v' == line[0] && 'n' == line[1]) {
-      Vector3 v;
-      parse(v, &line[3]);  //skip 3 chars
-      nos.push_back(v);
-    }
-
-    if ('v' == line[0] && 't' == line[1]) {
-      Vector2 v;
-      parse(v, &line[3]);  //skip 3 chars
-      uvs.push_back(v);
-    }
-
-    if ('f' == line[0] && ' ' == line[1]) {
-      char *toks[3];
-      toks[0] = strtok(&line[2], " \n");
-      toks[1] = strtok( NULL, " \n");
-      toks[2] = strtok( NULL, " \n");
-
-      Face f;
-      f.v0.parse(toks[0]);
-      f.v1.parse(toks[1]);
-      f.v2.parse(toks[2]);
-      faces.push_back(f);
-    }
-  }
-  printf(" * no. of vertices.: %zu\n", coords.size());
-  printf(" * no. of normals..: %zu\n", nos.size());
-  printf(" * no. of texcoords: %zu\n", uvs.size());
-  printf(" * no. of faces....: %zu\n", faces.size());
-  return true;
-}
-
-bool ColoredObj::Vertex::operator <(const Vertex &rhs) const {
-  if (p < rhs.p)
-    return true;
-  if (p > rhs.p)
-    return false;
-
-  if (n < rhs.n)
-    return true;
-
-  if (t < rhs.t)
-    return true;
-  if (t > rhs.t)
-    return false;
-
-  return false;
-}
-
-bool ColoredObj::Vertex::operator >(const Vertex &rhs) const {
-  return rhs < *this;
-}
-
-bool ColoredObj::Vertex::operator ==(const Vertex &rhs) const {
-  return p == rhs.p && t == rhs.t && t == rhs.t;
-}
-
-bool ColoredObj::load(std::string_view fileName) {
-  const char *tag = "ColoredObj::Load";
-
-  //0,1,2, info/warn/error
-  auto print = [&](int type, std::string_view format, ...) {
-    std::stringstream ss;
-    char buffer[1024];
-    if (0 == type)
-      ss << "[INFO]..: " << tag << " - ";
-    if (1 == type)
-      ss << "[WARN]..: " << tag << " - ";
-    if (2 == type)
-      ss << "[ERROR].: " << tag << " - ";
-
-    va_list args;
-    va_start(args, format);
-    vsnprintf(buffer, sizeof(buffer), format.data(), args);
-    va_end(args);
-    ss << buffer;
-    printf("%s\n", ss.str().c_str());
-  };
-
-  FILE *fp = fopen(fileName.data(), "r");
-
-  if (!fp) {
-    print(2, "file '%s' not found", fileName.data());
-    return false;
-  }
-  print(0, "loading OBJ from file '%s'", fileName.data());
-
-  coords.clear();
-  uvs.clear();
-  matNames.clear();
-  faces.clear();
-
-  char line[256];
-
-  std::string matCurr;
-  int matIndex;
-  while (fgets(line, sizeof(line), fp)) {
-    if ('v' == line[0] && ' ' == line[1]) {
-      Vector3 v;
-      sscanf(&line[2], "%f, %f, %f", &v.x, &v.y, &v.z);
-      coords.push_back(v);
-    }
-
-    if ('v' == line[0] && 'n' == line[1]) {
-      Vector3 v;
-      sscanf(&line[3], "%f, %f, %f", &v.x, &v.y, &v.z);
-      nos.push_back(v);
-    }
-
-    if ('v' == line[0] && 't' == line[1]) {
-      Vector2 v;
-      sscanf(&line[3], "%f, %f", &v.x, &v.y);
-      uvs.push_back(v);
-    }
-
-    if (0 == memcmp("usemtl", line, 6)) {
-      matNames.push_back(std::string(strtok(&line[7], " \n")));
-      matCurr = matNames.back();
-      matIndex = (int) matNames.size() - 1;
-    }
-    if ('f' == line[0] && ' ' == line[1]) {
-      Face face;
-      face.m = matIndex;
-      sscanf(strtok(&line[2], " \n"), "%d/%d/%d", &face.v.p, &face.v.n, &face.v.uv);
-      sscanf(strtok(nullptr, " \n"), "%d/%d/%d", &face.v2.p, &face.v2.n, &face.v2.uv);
-      sscanf(strtok(nullptr, " \n"), "%d/%d/%d", &face.v3.p, &face.v3.n, &face.v3.uv);
-      faces.push_back(face);
-      matFaces[matCurr].push_back((int) faces.size() - 1);
-    }
-  }
-  fclose(fp);
-
-  std::set<Vertex> sortedVerts;
-  for (auto &f : faces) {
-    for (int i = 0; i < 3; i++) {
-      f.verts[i].p = coords[f.vs[i].p - 1];
-      f.verts[i].n = nos[f.vs[i].n - 1];
-      f.verts[i].t = uvs[f.vs[i].uv - 1];
-      sortedVerts.insert(f.verts[i]);
-    }
-  }
-
-  // these are now sorted
-  for (auto vert : sortedVerts)
-    vertices.push_back(vert);
-
-  auto find = [&](const Vertex &v) {
-    int l = 0;
-    int r = (int) vertices.size() - 1;
-    while (l <= r) {
-      int m = (l + r) / 2;
-      if (vertices[m] < v)
-        l = m + 1;
-      else if (vertices[m] > v)
-        r = m - 1;
-      return m;
-    }
-    return -1;
-  };
-
-  for (auto &face : faces) {
-    face.ids[0] = find(face.verts[0]);
-    face.ids[1] = find(face.verts[1]);
-    face.ids[2] = find(face.verts[2]);
-    indices.push_back(face.ids[0]);
-    indices.push_back(face.ids[1]);
-    indices.push_back(face.ids[2]);
-  }
-
-  return true;
-}
-
-bool ColoredObj::loadMaterials(std::string_view fileName) {
-  const char *tag = "ColoredObj::laodMaterials";
-
-  //0,1,2, info/warn/error
-  auto print = [&](int type, std::string_view format, ...) {
-    std::stringstream ss;
-    char buffer[1024];
-    if (0 == type)
-      ss << "[INFO]..: " << tag << " - ";
-    if (1 == type)
-      ss << "[WARN]..: " << tag << " - ";
-    if (2 == type)
-      ss << "[ERROR].: " << tag << " - ";
-
-    va_list args;
-    va_start(args, format);
-    vsnprintf(buffer, sizeof(buffer), format.data(), args);
-    va_end(args);
-    ss << buffer;
-    printf("%s\n", ss.str().c_str());
-  };
-
-  FILE *fp = fopen(fileName.data(), "r");
-
-  if (!fp) {
-    print(2, "file '%s' not found", fileName.data());
-    return false;
-  }
-  print(0, "loading OBJ materials from file '%s'", fileName.data());
-
-  char line[256];
-  int lineNo = -1;
-  while (fgets(line, sizeof(line), fp)) {
-    lineNo++;
-    if ('#' == line[0])
-      continue;
-    auto *p = strchr(line, '\n');
-    if (p)
-      *p = '\0';
-
-    print(0, "%s", line);
-
-    char *toks[3];
-    toks[0] = strtok(line, " \n");
-    toks[1] = strtok(nullptr, " \n");
-    toks[2] = strtok(nullptr, " \n");
-    if (toks[0] == nullptr || toks[1] == nullptr || toks[2] == nullptr) {
-      print(1, "invalid material at line %d", lineNo);
-    }
-    auto &material = materials[std::string(toks[0])];
-    material.name = std::string(toks[0]);
-    material.albedo.fromHex(toks[1]);
-    material.emission.fromHex(toks[2]);
-  }
-
-  return true;
-}
-
-}
+#include "obj.h"
+#include "mappedfile.h"
+#include "textscan.h"
+#include "linechunks.h"
+#include "vertexindexer.h"
+#include "normals.h"
+#include "weld.h"
+
+#include <sstream>
+#include <cstring>
+#include <cstdarg>
+#include <sstream>
+
+namespace wavefront {
+
+bool Vertex::operator <(const Vertex &rhs) const {
+  if (vp < rhs.vp)
+    return true;
+  else if (vp > rhs.vp)
+    return false;
+  else {
+    if (vn < rhs.vn)
+      return true;
+    else if (vn > rhs.vn)
+      return false;
+    else {
+      if (vt < rhs.vt)
+        return true;
+      else if (vt >= rhs.vt)
+        return false;
+    }
+  }
+  return false;
+}
+
+bool Vertex::operator >(const Vertex &rhs) const {
+  return rhs < *this;
+}
+
+bool Vertex::operator ==(const Vertex &rhs) const {
+  return vp == rhs.vp && vn == rhs.vn && vt == rhs.vt;
+}
+
+void Vertex::parse(const char *text) {
+  scan(text, text + strlen(text));
+}
+
+// scans one 'vp', 'vp/vn', 'vp/vt/vn' or 'vp//vn' token in place, returns the end of the token
+const char* Vertex::scan(const char *text, const char *end) {
+  int32 fields[3] = { 0, 0, 0 };
+  bool present[3] = { false, false, false };
+  int32 numSlashes = 0;
+
+  const char *p = text;
+  while (p < end && !textscan::isEndOfToken(*p)) {
+    if ('/' == *p) {
+      numSlashes += numSlashes < 2 ? 1 : 0;
+      p++;
+      continue;
+    }
+    const char *q = textscan::scanInt(p, end, fields[numSlashes]);
+    if (q == p) {
+      p++;
+      continue;
+    }
+    present[numSlashes] = true;
+    p = q;
+  }
+
+  vn = vt = -1;
+  vp = fields[0] - 1;
+
+  if (1 == numSlashes)
+    vn = fields[1] - 1;
+
+  if (2 == numSlashes) {
+    if (present[1])  //int the case of 'vp//vn', where there is no 'vt'
+      vt = fields[1] - 1;
+    vn = fields[2] - 1;
+  }
+  return p;
+}
+
+namespace {
+
+std::string objFileName(std::string_view dir, std::string_view name, int frame) {
+  std::stringstream ss;
+  ss << dir;
+  ss << "/";
+  ss << name;
+  if (frame > 0) {
+    char buff[64];
+    sprintf(buff, "_%.6u", frame);
+    ss << std::string(buff);
+  }
+  ss << ".obj";
+  return ss.str();
+}
+
+// 8 bytes a step, only compared between files read by the same build
+uint64 hashText(uint64 h, const char *p, size_t n) {
+  const uint64 m = 0x9E3779B97F4A7C15ull;
+  for (; n >= 8; p += 8, n -= 8) {
+    uint64 w;
+    memcpy(&w, p, 8);
+    h = (h ^ w) * m;
+    h ^= h >> 29;
+  }
+  uint64 w = 0;
+  memcpy(&w, p, n);
+  h = (h ^ w ^ (uint64) n << 56) * m;
+  return h ^ (h >> 32);
+}
+
+std::vector<uint32> cornersOf(const std::vector<Face> &faces) {
+  std::vector<uint32> corners;
+  corners.reserve(faces.size() * 3);
+  for (const auto &f : faces) {
+    corners.push_back((uint32) f.v0.vp);
+    corners.push_back((uint32) f.v1.vp);
+    corners.push_back((uint32) f.v2.vp);
+  }
+  return corners;
+}
+
+// corners without 'vn' get smooth normals of 'coords', one per position and appended to 'nos' so every frame
+// of an animation numbers them the same way; returns the index of the first one, -1 if none were needed
+int generateMissingNormals(const std::vector<Vector3> &coords, std::vector<Face> &faces, std::vector<Vector3> &nos) {
+  size_t numMissing = 0;
+  for (const auto &f : faces)
+    numMissing += (f.v0.vn < 0 ? 1 : 0) + (f.v1.vn < 0 ? 1 : 0) + (f.v2.vn < 0 ? 1 : 0);
+  if (!numMissing)
+    return -1;
+
+  std::vector<Vector3> generated;
+  std::vector<uint32> cornerNormals;
+  normals::generate(coords, cornersOf(faces), 180.0f, 0, generated, cornerNormals);
+  int first = (int) nos.size();
+  nos.insert(nos.end(), generated.begin(), generated.end());
+  for (auto &f : faces) {
+    for (Vertex *v : { &f.v0, &f.v1, &f.v2 })
+      v->vn = v->vn < 0 ? first + v->vp : v->vn;
+  }
+  printf(" * generated %zu normals for %zu corners\n", generated.size(), numMissing);
+  return first;
+}
+
+}
+
+bool SimpleObj::loadFromFile(std::string_view dir, std::string_view name, int frame) {
+  filename = objFileName(dir, name, frame);
+
+  MappedFile file(filename);
+  if (!file.valid()) {
+    printf("%s - file '%s' not found\n", __FUNCTION__, filename.c_str());
+    filename = "";
+    return false;
+  }
+  printf("%s - loading OBJ data from file '%s'\n", __FUNCTION__, filename.c_str());
+  coords.clear();
+  nos.clear();
+  uvs.clear();
+  faces.clear();
+  faceHash = 0;
+
+  // the file is scanned in place: no line copies, no tokenizing, no locale lookups
+  using namespace textscan;
+  const char *end = file.end();
+  for (const char *line = file.begin(); line < end; line = nextLine(line, end)) {
+    if (end - line < 2)
+      break;
+
+    if ('v' == line[0] && ' ' == line[1]) {
+      Vector3 v;
+      const char *p = line + 2;
+      for (int i = 0; i < 3; i++)
+        p = scanFloat(skipBlanks(p, end), end, v.xyz[i]);
+      coords.push_back(v);
+    }
+
+    else if ('v' == line[0] && 'n' == line[1]) {
+      Vector3 v;
+      const char *p = line + 2;
+      for (int i = 0; i < 3; i++)
+        p = scanFloat(skipBlanks(p, end), end, v.xyz[i]);
+      nos.push_back(v);
+    }
+
+    else if ('v' == line[0] && 't' == line[1]) {
+      Vector2 v;
+      const char *p = line + 2;
+      for (int i = 0; i < 2; i++)
+        p = scanFloat(skipBlanks(p, end), end, v.xy[i]);
+      uvs.push_back(v);
+    }
+
+    else if ('f' == line[0] && ' ' == line[1]) {
+      Face f;
+      const char *p = line + 2;
+      p = f.v0.scan(skipBlanks(p, end), end);
+      p = f.v1.scan(skipBlanks(p, end), end);
+      p = f.v2.scan(skipBlanks(p, end), end);
+      faces.push_back(f);
+      faceHash = hashText(faceHash, line, nextLine(line, end) - line);
+    }
+  }
+
+  firstGenerated = generateMissingNormals(coords, faces, nos);
+  printf(" * no. of vertices.: %zu\n", coords.size());
+  printf(" * no. of normals..: %zu\n", nos.size());
+  printf(" * no. of texcoords: %zu\n", uvs.size());
+  printf(" * no. of faces....: %zu\n", faces.size());
+  return true;
+}
+
+bool SimpleObj::loadFrame(std::string_view dir, std::string_view name, int frame, const SimpleObj &base) {
+  filename = objFileName(dir, name, frame);
+
+  MappedFile file(filename);
+  if (!file.valid()) {
+    printf("%s - file '%s' not found\n", __FUNCTION__, filename.c_str());
+    filename = "";
+    return false;
+  }
+  coords.clear();
+  nos.clear();
+  uvs.clear();
+  faces.clear();
+  faceHash = 0;
+  firstGenerated = -1;
+
+  // only the positions and normals are scanned, the faces are hashed as they are
+  using namespace textscan;
+  coords.reserve(base.coords.size());
+  nos.reserve(base.nos.size());
+  const char *end = file.end();
+  for (const char *line = file.begin(); line < end;) {
+    const char *next = nextLine(line, end);
+    if (end - line < 2)
+      break;
+
+    if ('v' == line[0] && ' ' == line[1]) {
+      Vector3 v;
+      const char *p = line + 2;
+      for (int i = 0; i < 3; i++)
+        p = scanFloat(skipBlanks(p, end), end, v.xyz[i]);
+      coords.push_back(v);
+    }
+
+    else if ('v' == line[0] && 'n' == line[1]) {
+      Vector3 v;
+      const char *p = line + 2;
+      for (int i = 0; i < 3; i++)
+        p = scanFloat(skipBlanks(p, end), end, v.xyz[i]);
+      nos.push_back(v);
+    }
+
+    else if ('f' == line[0] && ' ' == line[1]) {
+      faceHash = hashText(faceHash, line, next - line);
+    }
+    line = next;
+  }
+
+  // the base's own 'vn' lines, its generated normals follow them
+  size_t numNormals = base.firstGenerated >= 0 ? (size_t) base.firstGenerated : base.nos.size();
+  bool sameTopology = faceHash == base.faceHash && coords.size() == base.coords.size() && nos.size() == numNormals;
+  if (!sameTopology) {
+    // written differently, e.g. by another exporter; compare what the faces say
+    SimpleObj parsed;
+    if (!parsed.loadFromFile(dir, name, frame))
+      return false;
+    sameTopology = parsed.coords.size() == base.coords.size() && parsed.nos.size() == base.nos.size() &&
+                   parsed.faces.size() == base.faces.size();
+    for (size_t i = 0; sameTopology && i < base.faces.size(); i++) {
+      const Face &f = parsed.faces[i], &g = base.faces[i];
+      sameTopology = f.v0 == g.v0 && f.v1 == g.v1 && f.v2 == g.v2;
+    }
+    if (!sameTopology) {
+      printf("%s - '%s' doesn't share the topology of '%s'\n", __FUNCTION__, filename.c_str(), base.filename.c_str());
+      return false;
+    }
+    coords.swap(parsed.coords);
+    nos.swap(parsed.nos);
+    firstGenerated = parsed.firstGenerated;
+    return true;
+  }
+
+  // the base's faces, with its generated normal ids, stand in for the ones that were only hashed
+  if (base.firstGenerated >= 0) {
+    std::vector<Vector3> generated;
+    std::vector<uint32> cornerNormals;
+    normals::generate(coords, cornersOf(base.faces), 180.0f, 0, generated, cornerNormals);
+    firstGenerated = (int) nos.size();
+    nos.insert(nos.end(), generated.begin(), generated.end());
+  }
+  printf("%s - frame '%s': %zu vertices, %zu normals\n", __FUNCTION__, filename.c_str(), coords.size(), nos.size());
+  return true;
+}
+
+namespace {
+
+// lines parsed by one thread; material indices are local to the chunk
+struct ColoredObjChunk {
+  std::vector<Vector3> coords;
+  std::vector<Vector3> nos;
+  std::vector<Vector2> uvs;
+  std::vector<std::string> matNames;
+  std::vector<ColoredObj::Face> faces;
+
+  // comma separated, e.g. 'v 1.0, 2.0, 3.0'
+  static const char* scanFloats(const char *p, const char *end, float *fs, int n) {
+    using namespace textscan;
+    for (int i = 0; i < n; i++) {
+      if (i > 0) {
+        if (p >= end || ',' != *p)
+          break;
+        p++;
+      }
+      const char *q = scanFloat(skipBlanks(p, end), end, fs[i]);
+      if (q == skipBlanks(p, end))
+        break;
+      p = q;
+    }
+    return p;
+  }
+
+  // 'p/n/uv', stops at the first missing field
+  static const char* scanCorner(const char *p, const char *end, ColoredObj::Face::Vertex &v) {
+    using namespace textscan;
+    int *fields[3] = { &v.p, &v.n, &v.uv };
+    p = skipBlanks(p, end);
+    for (int i = 0; i < 3; i++) {
+      if (i > 0) {
+        if (p >= end || '/' != *p)
+          break;
+        p++;
+      }
+      const char *q = scanInt(p, end, *fields[i]);
+      if (q == p)
+        break;
+      p = q;
+    }
+    while (p < end && !isEndOfToken(*p))
+      p++;
+    return p;
+  }
+
+  void parse(const char *begin, const char *end) {
+    using namespace textscan;
+    int matIndex = -1;
+    for (const char *line = begin; line < end; line = nextLine(line, end)) {
+      if (end - line < 2)
+        break;
+
+      if ('v' == line[0] && ' ' == line[1]) {
+        Vector3 v;
+        scanFloats(line + 2, end, v.xyz, 3);
+        coords.push_back(v);
+      }
+
+      else if ('v' == line[0] && 'n' == line[1]) {
+        Vector3 v;
+        scanFloats(line + 2, end, v.xyz, 3);
+        nos.push_back(v);
+      }
+
+      else if ('v' == line[0] && 't' == line[1]) {
+        Vector2 v;
+        scanFloats(line + 2, end, v.xy, 2);
+        uvs.push_back(v);
+      }
+
+      else if (end - line > 6 && 0 == memcmp("usemtl", line, 6)) {
+        const char *p = skipBlanks(line + 6, end);
+        const char *q = p;
+        while (q < end && !isEndOfToken(*q))
+          q++;
+        matNames.push_back(std::string(p, q));
+        matIndex = (int) matNames.size() - 1;
+      }
+
+      else if ('f' == line[0] && ' ' == line[1]) {
+        ColoredObj::Face face;
+        face.m = matIndex;
+        const char *p = line + 2;
+        for (int i = 0; i < 3; i++) {
+          face.vs[i].p = face.vs[i].n = face.vs[i].uv = 0;
+          p = scanCorner(p, end, face.vs[i]);
+        }
+        faces.push_back(face);
+      }
+    }
+  }
+};
+
+}
+
+bool ColoredObj::Vertex::operator <(const Vertex &rhs) const {
+  if (p < rhs.p)
+    return true;
+  if (p > rhs.p)
+    return false;
+
+  if (n < rhs.n)
+    return true;
+  if (n > rhs.n)
+    return false;
+
+  if (t < rhs.t)
+    return true;
+  if (t > rhs.t)
+    return false;
+
+  return false;
+}
+
+bool ColoredObj::Vertex::operator >(const Vertex &rhs) const {
+  return rhs < *this;
+}
+
+bool ColoredObj::Vertex::operator ==(const Vertex &rhs) const {
+  return !(*this < rhs) && !(rhs < *this);
+}
+
+bool ColoredObj::load(std::string_view fileName, uint32 numThreads, float creaseAngle) {
+  const char *tag = "ColoredObj::Load";
+
+  //0,1,2, info/warn/error
+  auto print = [&](int type, std::string_view format, ...) {
+    std::stringstream ss;
+    char buffer[1024];
+    if (0 == type)
+      ss << "[INFO]..: " << tag << " - ";
+    if (1 == type)
+      ss << "[WARN]..: " << tag << " - ";
+    if (2 == type)
+      ss << "[ERROR].: " << tag << " - ";
+
+    va_list args;
+    va_start(args, format);
+    vsnprintf(buffer, sizeof(buffer), format.data(), args);
+    va_end(args);
+    ss << buffer;
+    printf("%s\n", ss.str().c_str());
+  };
+
+  MappedFile file(fileName);
+
+  if (!file.valid()) {
+    print(2, "file '%s' not found", fileName.data());
+    return false;
+  }
+
+  auto lines = splitLines(file.begin(), file.end(), numThreads);
+  print(0, "loading OBJ from file '%s' (%zu chunks)", fileName.data(), lines.size());
+
+  coords.clear();
+  nos.clear();
+  uvs.clear();
+  matNames.clear();
+  faces.clear();
+  vertices.clear();
+  indices.clear();
+  ranges.clear();
+
+  std::vector<ColoredObjChunk> chunks(lines.size());
+  forEachChunk(lines, [&](size_t i, const char *begin, const char *end) {
+    chunks[i].parse(begin, end);
+  });
+
+  // stitch the chunks in file order: chunk-local material indices are mapped to unique material ids
+  // (one name lookup per 'usemtl', never per face), and faces that precede the chunk's first 'usemtl'
+  // inherit whatever material was current at the end of the previous chunk
+  size_t numCoords = 0, numNos = 0, numUvs = 0, numFaces = 0;
+  for (const auto &chunk : chunks) {
+    numCoords += chunk.coords.size();
+    numNos += chunk.nos.size();
+    numUvs += chunk.uvs.size();
+    numFaces += chunk.faces.size();
+  }
+  coords.reserve(numCoords);
+  nos.reserve(numNos);
+  uvs.reserve(numUvs);
+
+  std::map<std::string, int> matIds;
+  int matIndex = -1;
+  std::vector<int> chunkMats;
+  for (auto &chunk : chunks) {
+    coords.insert(coords.end(), chunk.coords.begin(), chunk.coords.end());
+    nos.insert(nos.end(), chunk.nos.begin(), chunk.nos.end());
+    uvs.insert(uvs.end(), chunk.uvs.begin(), chunk.uvs.end());
+    chunkMats.clear();
+    for (auto &name : chunk.matNames) {
+      auto it = matIds.find(name);
+      if (it == matIds.end()) {
+        it = matIds.emplace(name, (int) matNames.size()).first;
+        matNames.push_back(std::move(name));
+      }
+      chunkMats.push_back(it->second);
+    }
+    for (auto &face : chunk.faces)
+      face.m = face.m < 0 ? matIndex : chunkMats[face.m];
+    if (chunkMats.size())
+      matIndex = chunkMats.back();
+  }
+
+  // counting sort by material, faces keep their file order within a material; bucket 0 holds
+  // the faces without one, bucket m + 1 those of material m
+  std::vector<uint32> firstFace(matNames.size() + 2, 0);
+  for (const auto &chunk : chunks)
+    for (const auto &face : chunk.faces)
+      firstFace[face.m + 2]++;
+  for (size_t m = 1; m < firstFace.size(); m++)
+    firstFace[m] += firstFace[m - 1];
+  std::vector<uint32> nextFace(firstFace.begin(), firstFace.end() - 1);
+  faces.resize(numFaces);
+  for (const auto &chunk : chunks)
+    for (const auto &face : chunk.faces)
+      faces[nextFace[face.m + 1]++] = face;
+  chunks.clear();
+
+  for (size_t b = 0; b + 1 < firstFace.size(); b++) {
+    if (firstFace[b + 1] > firstFace[b])
+      ranges.push_back(Range { (int32) b - 1, firstFace[b] * 3, (firstFace[b + 1] - firstFace[b]) * 3 });
+  }
+
+  // corners without 'vn' get generated normals, appended to nos
+  size_t numMissing = 0;
+  for (const auto &f : faces)
+    for (int i = 0; i < 3; i++)
+      numMissing += f.vs[i].n <= 0 ? 1 : 0;
+  if (numMissing) {
+    std::vector<uint32> corners(faces.size() * 3);
+    for (size_t i = 0; i < faces.size(); i++)
+      for (int j = 0; j < 3; j++)
+        corners[i * 3 + j] = (uint32) (faces[i].vs[j].p - 1);
+    std::vector<Vector3> generated;
+    std::vector<uint32> cornerNormals;
+    normals::generate(coords, corners, creaseAngle, numThreads, generated, cornerNormals);
+    int first = (int) nos.size() + 1;
+    nos.insert(nos.end(), generated.begin(), generated.end());
+    for (size_t i = 0; i < faces.size(); i++)
+      for (int j = 0; j < 3; j++)
+        if (faces[i].vs[j].n <= 0)
+          faces[i].vs[j].n = first + (int) cornerNormals[i * 3 + j];
+    print(0, "generated %zu normals for %zu corners", generated.size(), numMissing);
+  }
+
+  VertexIndexer indexer;
+  indexer.reserve(faces.size() * 3);
+  indices.reserve(faces.size() * 3);
+  for (auto &f : faces) {
+    for (int i = 0; i < 3; i++) {
+      uint32 id = indexer.index(f.vs[i].p, f.vs[i].n, f.vs[i].uv);
+      if (id == vertices.size()) {
+        Vertex v;
+        v.p = coords[f.vs[i].p - 1];
+        v.n = nos[f.vs[i].n - 1];
+        v.t = f.vs[i].uv > 0 ? uvs[f.vs[i].uv - 1] : Vector2();
+        vertices.push_back(v);
+      }
+      f.ids[i] = (int) id;
+      indices.push_back(id);
+    }
+  }
+
+  return true;
+}
+
+uint32 ColoredObj::weld(float epsilon, float attributeEpsilon) {
+  std::vector<Vertex> welded;
+  std::vector<uint32> remap;
+  uint32 numMerged = weld::weld(vertices, epsilon, attributeEpsilon, welded, remap);
+  vertices.swap(welded);
+
+  IndexBuffer remapped;
+  remapped.reserve(indices.size());
+  for (size_t i = 0; i < indices.size(); i++)
+    remapped.push_back(remap[indices[i]]);
+  indices = std::move(remapped);
+
+  for (auto &f : faces)
+    for (int i = 0; i < 3; i++)
+      f.ids[i] = (int) remap[f.ids[i]];
+  printf("%s - %u of %zu vertices merged (epsilon %g)\n", __FUNCTION__, numMerged, remap.size(), epsilon);
+  return numMerged;
+}
+
+const ColoredObj::Range* ColoredObj::findRange(std::string_view material) const {
+  for (const auto &range : ranges) {
+    if ((range.material < 0 ? std::string_view() : std::string_view(matNames[range.material])) == material)
+      return &range;
+  }
+  return nullptr;
+}
+
+bool ColoredObj::loadMaterials(std::string_view fileName) {
+  const char *tag = "ColoredObj::laodMaterials";
+
+  //0,1,2, info/warn/error
+  auto print = [&](int type, std::string_view format, ...) {
+    std::stringstream ss;
+    char buffer[1024];
+    if (0 == type)
+      ss << "[INFO]..: " << tag << " - ";
+    if (1 == type)
+      ss << "[WARN]..: " << tag << " - ";
+    if (2 == type)
+      ss << "[ERROR].: " << tag << " - ";
+
+    va_list args;
+    va_start(args, format);
+    vsnprintf(buffer, sizeof(buffer), format.data(), args);
+    va_end(args);
+    ss << buffer;
+    printf("%s\n", ss.str().c_str());
+  };
+
+  FILE *fp = fopen(fileName.data(), "r");
+
+  if (!fp) {
+    print(2, "file '%s' not found", fileName.data());
+    return false;
+  }
+  print(0, "loading OBJ materials from file '%s'", fileName.data());
+
+  char line[256];
+  int lineNo = -1;
+  while (fgets(line, sizeof(line), fp)) {
+    lineNo++;
+    if ('#' == line[0])
+      continue;
+    auto *p = strchr(line, '\n');
+    if (p)
+      *p = '\0';
+
+    print(0, "%s", line);
+
+    char *toks[3];
+    toks[0] = strtok(line, " \n");
+    toks[1] = strtok(nullptr, " \n");
+    toks[2] = strtok(nullptr, " \n");
+    if (toks[0] == nullptr || toks[1] == nullptr || toks[2] == nullptr) {
+      print(1, "invalid material at line %d", lineNo);
+    }
+    auto &material = materials[std::string(toks[0])];
+    material.name = std::string(toks[0]);
+    material.albedo.fromHex(toks[1]);
+    material.emission.fromHex(toks[2]);
+  }
+
+  return true;
+}
+
+}
@@ -1,114 +1,136 @@
-#pragma once
-
-#include <vector>
-#include <string>
-#include <string_view>
-#include <map>
-
-#include "defs.h"
-#include "myvector.h"
-
-
-namespace wavefront {
-
-struct Vertex {
-  int vp, vn, vt;
-
-  Vertex() {
-    vp = vn = vt = -1;
-  }
-
-  Vertex(int vp, int vn, int vt) {
-    this->vp = vp;
-    this->vn = vn;
-    this->vt = vt;
-  }
-
-  Vertex(const char *text) {
-    parse(text);
-  }
-
-  ~Vertex() {
-    vp = vn = vt = -1;
-  }
-
-  bool operator <(const Vertex &rhs) const;
-  bool operator >(const Vertex &rhs) const;
-  bool operator ==(const Vertex &rhs) const;
-
-  void parse(const char *text);
-
-  std::string print() {
-    char tmp[256];
-    sprintf(tmp, "(%d,%d,%d)", vp, vn, vt);
-    return std::string(tmp);
-  }
-};
-
-struct Face {
-  Vertex v0, v1, v2;
-};
-
-// Simple, contains no material information
-struct SimpleObj {
-
-  std::string filename;
-  std::vector<Vector3> coords;
-  std::vector<Vector3> nos;
-  std::vector<Vector2> uvs;
-  std::vector<Face> faces;
-
-  bool loadFromFile(std::string_view dir, std::string_view name, int frame);
-};
-
-
-struct ColoredObj {
-  struct Material {
-    std::string name;
-    Color albedo;
-    Color emission;
-  };
-
-  struct Vertex {
-    Vector3 p;
-    Vector3 n;
-    Vector2 t;
-
-    bool operator <(const Vertex &rhs) const;
-    bool operator >(const Vertex &rhs) const;
-    bool operator ==(const Vertex &rhs) const;
-  };
-
-  struct Face {
-    struct Vertex {
-      int p;
-      int n;
-      int uv;
-    };
-    union {
-      struct {
-        Vertex v, v2, v3;
-      };
-      Vertex vs[3];
-    };
-    int m;
-    ColoredObj::Vertex verts[3];
-    int ids[3];
-  };
-
-  std::string fileName;
-  std::map<std::string, Material> materials;
-  std::map<std::string, std::vector<uint16>> matFaces;
-  std::vector<Vector3> coords;
-  std::vector<Vector3> nos;
-  std::vector<Vector2> uvs;
-  std::vector<std::string> matNames;
-  std::vector<Face> faces;
-  std::vector<Vertex> vertices;
-  std::vector<uint16> indices;
-
-  bool load(std::string_view fileName);
-  bool loadMaterials(std::string_view fileName);
-};
-
-}
+#pragma once
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <map>
+
+#include "defs.h"
+#include "myvector.h"
+#include "indexbuffer.h"
+
+
+namespace wavefront {
+
+struct Vertex {
+  int vp, vn, vt;
+
+  Vertex() {
+    vp = vn = vt = -1;
+  }
+
+  Vertex(int vp, int vn, int vt) {
+    this->vp = vp;
+    this->vn = vn;
+    this->vt = vt;
+  }
+
+  Vertex(const char *text) {
+    parse(text);
+  }
+
+  ~Vertex() {
+    vp = vn = vt = -1;
+  }
+
+  bool operator <(const Vertex &rhs) const;
+  bool operator >(const Vertex &rhs) const;
+  bool operator ==(const Vertex &rhs) const;
+
+  void parse(const char *text);
+  const char* scan(const char *text, const char *end);
+
+  std::string print() {
+    char tmp[256];
+    sprintf(tmp, "(%d,%d,%d)", vp, vn, vt);
+    return std::string(tmp);
+  }
+};
+
+struct Face {
+  Vertex v0, v1, v2;
+};
+
+// Simple, contains no material information
+struct SimpleObj {
+
+  std::string filename;
+  std::vector<Vector3> coords;
+  std::vector<Vector3> nos;
+  std::vector<Vector2> uvs;
+  std::vector<Face> faces;
+  uint64 faceHash = 0;      // of the 'f' lines' text, in order
+  int firstGenerated = -1;  // nos[firstGenerated + vp] are generated smooth normals, -1 if there are none
+
+  bool loadFromFile(std::string_view dir, std::string_view name, int frame);
+
+  // for animation frames sharing the base's topology: only the 'v' and 'vn' lines are parsed, the 'f' lines
+  // are just hashed and matched against base.faceHash. uvs and faces stay empty, faces index into 'base'.
+  // when the text differs the faces are parsed after all and compared, false if the topology isn't the same
+  bool loadFrame(std::string_view dir, std::string_view name, int frame, const SimpleObj &base);
+};
+
+
+struct ColoredObj {
+  struct Material {
+    std::string name;
+    Color albedo;
+    Color emission;
+  };
+
+  struct Vertex {
+    Vector3 p;
+    Vector3 n;
+    Vector2 t;
+
+    // exact and lexicographic over p, n, t; ColoredObj::weld() merges vertices that are only nearly equal
+    bool operator <(const Vertex &rhs) const;
+    bool operator >(const Vertex &rhs) const;
+    bool operator ==(const Vertex &rhs) const;
+  };
+
+  struct Face {
+    struct Vertex {
+      int p;
+      int n;
+      int uv;
+    };
+    union {
+      struct {
+        Vertex v, v2, v3;
+      };
+      Vertex vs[3];
+    };
+    int m;
+    int ids[3];       // into vertices
+  };
+
+  // the faces of one material (-1 = none), indices[firstIndex, firstIndex + count)
+  struct Range {
+    int32 material;
+    uint32 firstIndex;
+    uint32 count;
+  };
+
+  std::string fileName;
+  std::map<std::string, Material> materials;
+  std::vector<Vector3> coords;
+  std::vector<Vector3> nos;
+  std::vector<Vector2> uvs;
+  std::vector<std::string> matNames;  // unique material names, Face::m and Range::material index into it
+  std::vector<Face> faces;            // sorted by material, faces[i] is indices[i * 3 .. i * 3 + 2]
+  std::vector<Vertex> vertices;
+  IndexBuffer indices;                // 16-bit unless there are more than 65536 vertices
+  std::vector<Range> ranges;          // one per material in use, faces without a material first
+
+  // numThreads: 1 parses serially, 0 uses every hardware thread; the result is identical either way.
+  // corners without a normal get generated ones, split where faces meet at more than creaseAngle degrees
+  bool load(std::string_view fileName, uint32 numThreads = 1, float creaseAngle = 180.0f);
+  bool loadMaterials(std::string_view fileName);
+  // merges vertices within epsilon of each other (normals and uvs within attributeEpsilon), see weld::weld();
+  // faces and indices are remapped, returns the number of vertices merged away
+  uint32 weld(float epsilon, float attributeEpsilon = 0.0f);
+  const Range* findRange(std::string_view material) const;
+};
+
+}
@@ -0,0 +1,276 @@
+#include "pca.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace pca {
+
+namespace {
+
+// eigenvalues and eigenvectors of the symmetric n x n matrix in 'vectors', which is replaced by the
+// eigenvectors, values[k] going with column k, unsorted: Householder reduction to tridiagonal form, then
+// implicit QL (tred2 and tql2 of EISPACK, as in JAMA)
+void eigen(size_t n, std::vector<double> &values, std::vector<double> &vectors) {
+  auto V = [&](size_t i, size_t j) -> double& { return vectors[i * n + j]; };
+  std::vector<double> &d = values;
+  std::vector<double> e(n, 0.0);
+  d.resize(n);
+  if (!n)
+    return;
+
+  for (size_t j = 0; j < n; j++)
+    d[j] = V(n - 1, j);
+  for (size_t i = n - 1; i > 0; i--) {
+    double scale = 0.0, h = 0.0;
+    for (size_t k = 0; k < i; k++)
+      scale += fabs(d[k]);
+    if (0.0 == scale) {
+      e[i] = d[i - 1];
+      for (size_t j = 0; j < i; j++) {
+        d[j] = V(i - 1, j);
+        V(i, j) = 0.0;
+        V(j, i) = 0.0;
+      }
+    } else {
+      for (size_t k = 0; k < i; k++) {
+        d[k] /= scale;
+        h += d[k] * d[k];
+      }
+      double f = d[i - 1];
+      double g = f > 0.0 ? -sqrt(h) : sqrt(h);
+      e[i] = scale * g;
+      h -= f * g;
+      d[i - 1] = f - g;
+      for (size_t j = 0; j < i; j++)
+        e[j] = 0.0;
+      for (size_t j = 0; j < i; j++) {
+        f = d[j];
+        V(j, i) = f;
+        g = e[j] + V(j, j) * f;
+        for (size_t k = j + 1; k < i; k++) {
+          g += V(k, j) * d[k];
+          e[k] += V(k, j) * f;
+        }
+        e[j] = g;
+      }
+      f = 0.0;
+      for (size_t j = 0; j < i; j++) {
+        e[j] /= h;
+        f += e[j] * d[j];
+      }
+      double hh = f / (h + h);
+      for (size_t j = 0; j < i; j++)
+        e[j] -= hh * d[j];
+      for (size_t j = 0; j < i; j++) {
+        f = d[j];
+        g = e[j];
+        for (size_t k = j; k < i; k++)
+          V(k, j) -= f * e[k] + g * d[k];
+        d[j] = V(i - 1, j);
+        V(i, j) = 0.0;
+      }
+    }
+    d[i] = h;
+  }
+  for (size_t i = 0; i + 1 < n; i++) {
+    V(n - 1, i) = V(i, i);
+    V(i, i) = 1.0;
+    double h = d[i + 1];
+    if (0.0 != h) {
+      for (size_t k = 0; k <= i; k++)
+        d[k] = V(k, i + 1) / h;
+      for (size_t j = 0; j <= i; j++) {
+        double g = 0.0;
+        for (size_t k = 0; k <= i; k++)
+          g += V(k, i + 1) * V(k, j);
+        for (size_t k = 0; k <= i; k++)
+          V(k, j) -= g * d[k];
+      }
+    }
+    for (size_t k = 0; k <= i; k++)
+      V(k, i + 1) = 0.0;
+  }
+  for (size_t j = 0; j < n; j++) {
+    d[j] = V(n - 1, j);
+    V(n - 1, j) = 0.0;
+  }
+  V(n - 1, n - 1) = 1.0;
+  e[0] = 0.0;
+
+  for (size_t i = 1; i < n; i++)
+    e[i - 1] = e[i];
+  e[n - 1] = 0.0;
+  double f = 0.0, tst1 = 0.0;
+  const double eps = 2.220446049250313e-16;
+  for (size_t l = 0; l < n; l++) {
+    tst1 = std::max(tst1, fabs(d[l]) + fabs(e[l]));
+    size_t m = l;
+    while (m < n && fabs(e[m]) > eps * tst1)
+      m++;
+    if (m > l) {
+      for (int iteration = 0; iteration < 64; iteration++) {
+        double g = d[l];
+        double p = (d[l + 1] - g) / (2.0 * e[l]);
+        double r = p < 0.0 ? -hypot(p, 1.0) : hypot(p, 1.0);
+        d[l] = e[l] / (p + r);
+        d[l + 1] = e[l] * (p + r);
+        double dl1 = d[l + 1];
+        double h = g - d[l];
+        for (size_t i = l + 2; i < n; i++)
+          d[i] -= h;
+        f += h;
+
+        p = d[m];
+        double c = 1.0, c2 = 1.0, c3 = 1.0;
+        double el1 = e[l + 1];
+        double s = 0.0, s2 = 0.0;
+        for (size_t i = m; i-- > l;) {
+          c3 = c2;
+          c2 = c;
+          s2 = s;
+          g = c * e[i];
+          h = c * p;
+          r = hypot(p, e[i]);
+          e[i + 1] = s * r;
+          s = e[i] / r;
+          c = p / r;
+          p = c * d[i] - s * g;
+          d[i + 1] = h + s * (c * g + s * d[i]);
+          for (size_t k = 0; k < n; k++) {
+            h = V(k, i + 1);
+            V(k, i + 1) = s * V(k, i) + c * h;
+            V(k, i) = c * V(k, i) - s * h;
+          }
+        }
+        p = -s * s2 * c3 * el1 * e[l] / dl1;
+        e[l] = s * p;
+        d[l] = c * p;
+        if (fabs(e[l]) <= eps * tst1)
+          break;
+      }
+    }
+    d[l] += f;
+    e[l] = 0.0;
+  }
+}
+
+// the worst vertex distance left in the residuals
+float worstError(const std::vector<float> &residuals) {
+  float worst2 = 0.0f;
+  for (size_t i = 0; i < residuals.size() / 3; i++) {
+    const float *r = &residuals[i * 3];
+    worst2 = std::max(worst2, r[0] * r[0] + r[1] * r[1] + r[2] * r[2]);
+  }
+  return sqrtf(worst2);
+}
+
+}
+
+Basis compress(const std::vector<std::vector<Vector3>> &frames, float maxError, uint32 maxBases) {
+  Basis basis;
+  const size_t numFrames = frames.size();
+  if (!numFrames)
+    return basis;
+  const size_t numVertices = frames[0].size();
+  const size_t n = numVertices * 3;
+  basis.numVertices = (uint32) numVertices;
+
+  // mean shape, then the centered frames, which become the residuals as bases are taken out
+  std::vector<double> mean(n, 0.0);
+  for (const auto &frame : frames)
+    for (size_t i = 0; i < n; i++)
+      mean[i] += frame[i / 3].xyz[i % 3];
+  basis.mean.resize(n);
+  for (size_t i = 0; i < n; i++)
+    basis.mean[i] = (float) (mean[i] / numFrames);
+  std::vector<float> residuals(numFrames * n);
+  for (size_t f = 0; f < numFrames; f++)
+    for (size_t i = 0; i < n; i++)
+      residuals[f * n + i] = frames[f][i / 3].xyz[i % 3] - basis.mean[i];
+  basis.error = worstError(residuals);
+
+  // Gram matrix of the centered frames, its eigenvectors map to the principal components. a slice of every
+  // frame at a time, so the slices stay in cache for all the pairs
+  std::vector<double> gram(numFrames * numFrames, 0.0);
+  const size_t slice = 1024;
+  for (size_t first = 0; first < n; first += slice) {
+    const size_t last = std::min(n, first + slice);
+    for (size_t a = 0; a < numFrames; a++) {
+      const float *ra = &residuals[a * n];
+      for (size_t b = a; b < numFrames; b++) {
+        const float *rb = &residuals[b * n];
+        double sum[4] = { 0.0, 0.0, 0.0, 0.0 };
+        size_t i = first;
+        for (; i + 4 <= last; i += 4) {
+          sum[0] += (double) ra[i] * rb[i];
+          sum[1] += (double) ra[i + 1] * rb[i + 1];
+          sum[2] += (double) ra[i + 2] * rb[i + 2];
+          sum[3] += (double) ra[i + 3] * rb[i + 3];
+        }
+        for (; i < last; i++)
+          sum[0] += (double) ra[i] * rb[i];
+        gram[a * numFrames + b] += (sum[0] + sum[1]) + (sum[2] + sum[3]);
+      }
+    }
+  }
+  for (size_t a = 0; a < numFrames; a++)
+    for (size_t b = 0; b < a; b++)
+      gram[a * numFrames + b] = gram[b * numFrames + a];
+  std::vector<double> values;
+  eigen(numFrames, values, gram);
+  const std::vector<double> &vectors = gram;
+  std::vector<size_t> order(numFrames);
+  for (size_t k = 0; k < numFrames; k++)
+    order[k] = k;
+  std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return values[a] > values[b]; });
+
+  // take components, largest first, until every vertex of every frame is close enough; each basis is the
+  // normalized combination of the frames its eigenvector weighs, the coefficients are projections on it
+  std::vector<float> coefficients;
+  std::vector<double> u(n);
+  for (size_t k = 0; k < numFrames && basis.error > maxError && basis.numBases < maxBases; k++) {
+    size_t e = order[k];
+    if (values[e] <= 1e-12 * values[order[0]])
+      break;
+    std::fill(u.begin(), u.end(), 0.0);
+    for (size_t f = 0; f < numFrames; f++) {
+      double w = vectors[f * numFrames + e];
+      const float *p = frames[f][0].xyz;
+      for (size_t i = 0; i < n; i++)
+        u[i] += w * (p[i] - basis.mean[i]);
+    }
+    double length = 0.0;
+    for (double x : u)
+      length += x * x;
+    length = sqrt(length);
+    if (length <= 0.0)
+      break;
+    size_t first = basis.bases.size();
+    basis.bases.resize(first + n);
+    for (size_t i = 0; i < n; i++)
+      basis.bases[first + i] = (float) (u[i] / length);
+
+    // the coefficient takes this basis out of each frame's residual
+    const float *b = &basis.bases[first];
+    for (size_t f = 0; f < numFrames; f++) {
+      float *r = &residuals[f * n];
+      double c = 0.0;
+      for (size_t i = 0; i < n; i++)
+        c += (double) r[i] * b[i];
+      for (size_t i = 0; i < n; i++)
+        r[i] -= (float) c * b[i];
+      coefficients.push_back((float) c);
+    }
+    basis.numBases++;
+    basis.error = worstError(residuals);
+  }
+
+  // coefficients were gathered basis by basis, the file wants them frame by frame
+  basis.coefficients.resize(numFrames * basis.numBases);
+  for (size_t k = 0; k < basis.numBases; k++)
+    for (size_t f = 0; f < numFrames; f++)
+      basis.coefficients[f * basis.numBases + k] = coefficients[k * numFrames + f];
+  return basis;
+}
+
+}
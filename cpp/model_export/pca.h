@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "defs.h"
+#include "myvector.h"
+
+// principal component compression of vertex animation, see vertexbasis.h for the file
+namespace pca {
+
+struct Basis {
+  uint32 numVertices = 0;
+  uint32 numBases = 0;
+  std::vector<float> mean;          // numVertices xyz
+  std::vector<float> bases;         // numBases x numVertices xyz, most variance first
+  std::vector<float> coefficients;  // numFrames x numBases
+  float error = 0.0f;               // worst vertex distance over every frame
+};
+
+// frames[f][v] is the position of vertex v in frame f. the fewest bases, up to maxBases, that rebuild every
+// vertex of every frame within 'maxError' model units; when even maxBases don't, error says how far off
+// they are. the components come from the eigenvectors of the frames' Gram matrix, numFrames x numFrames,
+// so the cost is O(numFrames^2 x numVertices) and the memory twice the frames'
+Basis compress(const std::vector<std::vector<Vector3>> &frames, float maxError, uint32 maxBases = ~0u);
+
+}
@@ -0,0 +1,407 @@
+#include "simplify.h"
+
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <unordered_map>
+
+namespace simplify {
+
+namespace {
+
+// sum of squared distances to a set of planes (Garland & Heckbert 1997), weighted by area; w is the total weight
+struct Quadric {
+  double a2 = 0, ab = 0, ac = 0, ad = 0, b2 = 0, bc = 0, bd = 0, c2 = 0, cd = 0, d2 = 0;
+  double w = 0;
+
+  void addPlane(const Vector3 &n, float d, double weight) {
+    double a = n.x, b = n.y, c = n.z;
+    a2 += weight * a * a; ab += weight * a * b; ac += weight * a * c; ad += weight * a * d;
+    b2 += weight * b * b; bc += weight * b * c; bd += weight * b * d;
+    c2 += weight * c * c; cd += weight * c * d;
+    d2 += weight * d * d;
+    w += weight;
+  }
+
+  void operator += (const Quadric &q) {
+    a2 += q.a2; ab += q.ab; ac += q.ac; ad += q.ad; b2 += q.b2; bc += q.bc; bd += q.bd;
+    c2 += q.c2; cd += q.cd; d2 += q.d2; w += q.w;
+  }
+
+  // mean squared distance of 'p' to the planes
+  double error(const Vector3 &p) const {
+    double x = p.x, y = p.y, z = p.z;
+    double e = a2 * x * x + b2 * y * y + c2 * z * z + 2 * (ab * x * y + ac * x * z + bc * y * z)
+             + 2 * (ad * x + bd * y + cd * z) + d2;
+    return w > 0 ? std::max(e, 0.0) / w : 0.0;
+  }
+};
+
+struct Collapse {
+  double cost;
+  uint32 u, v;
+  uint32 versionU, versionV;
+
+  bool operator < (const Collapse &rhs) const {
+    return cost > rhs.cost;  // min-heap
+  }
+};
+
+// border planes get this much more weight than the faces, so silhouettes of open meshes stay put
+const double borderWeight = 10.0;
+
+class Simplifier {
+public:
+  Simplifier(const std::vector<uint32> &indices, const std::vector<Vector3> &base,
+             const std::vector<std::vector<Vector3>> &frames, const std::vector<uint32> &groups,
+             size_t maxQuadricFrames)
+    : base(base), frames(frames), groups(groups) {
+    numFrames = frames.size() + 1;
+    numVertices = groups.size();
+    // evenly spaced from the base to the last frame
+    size_t numSampled = std::max(std::min(numFrames, maxQuadricFrames), (size_t) 1);
+    for (size_t i = 0; i < numSampled; i++)
+      sampled.push_back(numSampled > 1 ? (i * (numFrames - 1) + (numSampled - 1) / 2) / (numSampled - 1) : 0);
+    liveTris = (uint32) (indices.size() / 3);
+    tris.assign(indices.begin(), indices.end());
+    alive.assign(liveTris, 1);
+    vertTris.resize(numVertices);
+    for (uint32 t = 0; t < liveTris; t++)
+      for (int k = 0; k < 3; k++)
+        vertTris[tris[t * 3 + k]].push_back(t);
+    removed.assign(numVertices, 0);
+    version.assign(numVertices, 0);
+    members.resize(*std::max_element(groups.begin(), groups.end()) + 1);
+    for (uint32 v = 0; v < numVertices; v++)
+      members[groups[v]].push_back(v);
+    buildQuadrics();
+  }
+
+  uint32 triangles() const {
+    return liveTris;
+  }
+
+  float error() const {
+    return (float) sqrt(maxError);
+  }
+
+  std::vector<uint32> indices() const {
+    std::vector<uint32> out;
+    out.reserve(liveTris * 3);
+    for (size_t t = 0; t < alive.size(); t++)
+      if (alive[t])
+        out.insert(out.end(), tris.begin() + t * 3, tris.begin() + t * 3 + 3);
+    return out;
+  }
+
+  void queueAll() {
+    for (uint32 v = 0; v < numVertices; v++)
+      queueEdges(v);
+  }
+
+  // collapses the cheapest edges until at most 'target' triangles are left or nothing can collapse
+  void reduce(uint32 target) {
+    while (liveTris > target && queue.size()) {
+      Collapse c = queue.top();
+      queue.pop();
+      if (removed[c.u] || removed[c.v] || version[c.u] != c.versionU || version[c.v] != c.versionV)
+        continue;
+      double worst;
+      double cost = evaluate(c.u, c.v, collapsing, worst);
+      if (cost < 0)
+        continue;
+      if (cost > c.cost * 1.0001 + 1e-12) {
+        queue.push({ cost, c.u, c.v, c.versionU, c.versionV });
+        continue;
+      }
+      collapse(collapsing);
+      maxError = std::max(maxError, worst);
+    }
+  }
+
+private:
+  const std::vector<Vector3> &base;
+  const std::vector<std::vector<Vector3>> &frames;
+  const std::vector<uint32> &groups;
+  size_t numFrames, numVertices;                            // numFrames counts the base as frame 0
+  std::vector<size_t> sampled;                              // the frames the quadrics are gathered over
+
+  std::vector<uint32> tris;
+  std::vector<uint8> alive;
+  uint32 liveTris;
+  std::vector<std::vector<uint32>> vertTris;
+  std::vector<uint8> removed;
+  std::vector<uint32> version;
+  std::vector<std::vector<uint32>> members;                 // group -> live vertices
+  std::vector<Quadric> quadrics;                            // vertex * sampled.size() + sample
+  std::priority_queue<Collapse> queue;
+  double maxError = 0;
+  std::vector<uint32> neighbours;
+  std::vector<std::pair<uint32, uint32>> collapsing, queued, counts;
+
+  const Vector3 &position(uint32 v, size_t f) const {
+    return f ? frames[f - 1][groups[v]] : base[groups[v]];
+  }
+
+  static uint64 edgeKey(uint32 a, uint32 b) {
+    return a < b ? (uint64) a << 32 | b : (uint64) b << 32 | a;
+  }
+
+  void buildQuadrics() {
+    const size_t numSampled = sampled.size();
+    quadrics.assign(numVertices * numSampled, Quadric());
+
+    // triangles per position edge, the ones with a single triangle are on an open border
+    std::unordered_map<uint64, uint32> edgeCount;
+    for (uint32 t = 0; t < liveTris; t++)
+      for (int k = 0; k < 3; k++)
+        edgeCount[edgeKey(groups[tris[t * 3 + k]], groups[tris[t * 3 + (k + 1) % 3]])]++;
+
+    for (size_t s = 0; s < numSampled; s++) {
+      const size_t f = sampled[s];
+      for (uint32 t = 0; t < liveTris; t++) {
+        const uint32 *v = &tris[t * 3];
+        const Vector3 &p0 = position(v[0], f);
+        Vector3 n = (position(v[1], f) - p0).cross(position(v[2], f) - p0);
+        float len = n.length();
+        if (len <= 0.0f)
+          continue;
+        n *= 1.0f / len;
+        for (int k = 0; k < 3; k++)
+          quadrics[v[k] * numSampled + s].addPlane(n, -n.dot(p0), 0.5 * len);
+
+        for (int k = 0; k < 3; k++) {
+          uint32 a = v[k], b = v[(k + 1) % 3];
+          if (1 != edgeCount[edgeKey(groups[a], groups[b])])
+            continue;
+          Vector3 e = position(b, f) - position(a, f);
+          Vector3 bn = e.cross(n);
+          float bl = bn.length();
+          if (bl <= 0.0f)
+            continue;
+          bn *= 1.0f / bl;
+          double weight = borderWeight * e.dot(e);
+          quadrics[a * numSampled + s].addPlane(bn, -bn.dot(position(a, f)), weight);
+          quadrics[b * numSampled + s].addPlane(bn, -bn.dot(position(a, f)), weight);
+        }
+      }
+    }
+  }
+
+  bool hasEdge(uint32 a, uint32 b) const {
+    for (uint32 t : vertTris[a])
+      if (alive[t] && (tris[t * 3] == b || tris[t * 3 + 1] == b || tris[t * 3 + 2] == b))
+        return true;
+    return false;
+  }
+
+  // how many live triangles each neighbouring position of 'g' shares an edge with, over every seam twin
+  void neighbourGroups(uint32 g) {
+    counts.clear();
+    for (uint32 u : members[g]) {
+      for (uint32 t : vertTris[u]) {
+        if (!alive[t])
+          continue;
+        for (int k = 0; k < 3; k++) {
+          uint32 n = groups[tris[t * 3 + k]];
+          if (n == g)
+            continue;
+          auto it = std::find_if(counts.begin(), counts.end(), [n](const std::pair<uint32, uint32> &c) {
+            return c.first == n;
+          });
+          if (it == counts.end())
+            counts.push_back({ n, 1 });
+          else
+            it->second++;
+        }
+      }
+    }
+  }
+
+  // cost of collapsing u (and its twins) onto v (and its twins), -1 when the collapse isn't allowed;
+  // fills in the vertex pairs to collapse and the worst error over the frames
+  double evaluate(uint32 u, uint32 v, std::vector<std::pair<uint32, uint32>> &pairs, double &worst) {
+    uint32 gu = groups[u], gv = groups[v];
+    if (gu == gv)
+      return -1;
+
+    // every twin of u needs an edge to a twin of v, which it collapses onto
+    pairs.clear();
+    for (uint32 ui : members[gu]) {
+      int64 target = -1;
+      for (uint32 vj : members[gv]) {
+        if (hasEdge(ui, vj)) {
+          target = vj;
+          break;
+        }
+      }
+      if (target < 0)
+        return -1;
+      pairs.push_back({ ui, (uint32) target });
+    }
+
+    // a border position only moves along the border
+    neighbourGroups(gu);
+    bool border = false;
+    uint32 toV = 0;
+    for (const auto &c : counts) {
+      border |= 1 == c.second;
+      toV = c.first == gv ? c.second : toV;
+    }
+    if (border && 1 != toV)
+      return -1;
+
+    // no triangle may flip in any frame
+    for (const auto &pr : pairs) {
+      for (uint32 t : vertTris[pr.first]) {
+        const uint32 *tv = &tris[t * 3];
+        if (!alive[t] || tv[0] == pr.second || tv[1] == pr.second || tv[2] == pr.second)
+          continue;
+        for (size_t f = 0; f < numFrames; f++) {
+          Vector3 p[3], q[3];
+          for (int k = 0; k < 3; k++) {
+            p[k] = position(tv[k], f);
+            q[k] = tv[k] == pr.first ? position(pr.second, f) : p[k];
+          }
+          Vector3 n0 = (p[1] - p[0]).cross(p[2] - p[0]);
+          Vector3 n1 = (q[1] - q[0]).cross(q[2] - q[0]);
+          if (n0.dot(n1) <= 0.0f)
+            return -1;
+        }
+      }
+    }
+
+    const size_t numSampled = sampled.size();
+    double cost = 0;
+    worst = 0;
+    for (size_t s = 0; s < numSampled; s++) {
+      double e = 0;
+      for (const auto &pr : pairs) {
+        Quadric q = quadrics[pr.first * numSampled + s];
+        q += quadrics[pr.second * numSampled + s];
+        e = std::max(e, q.error(position(pr.second, sampled[s])));
+      }
+      cost += e;
+      worst = std::max(worst, e);
+    }
+    return cost / numSampled;
+  }
+
+  void collapse(const std::vector<std::pair<uint32, uint32>> &pairs) {
+    for (const auto &pr : pairs) {
+      uint32 u = pr.first, v = pr.second;
+      for (uint32 t : vertTris[u]) {
+        if (!alive[t])
+          continue;
+        uint32 *tv = &tris[t * 3];
+        for (int k = 0; k < 3; k++)
+          tv[k] = tv[k] == u ? v : tv[k];
+        // gone when it had the edge, or now spans a seam (two corners at one position)
+        if (groups[tv[0]] == groups[tv[1]] || groups[tv[1]] == groups[tv[2]] || groups[tv[0]] == groups[tv[2]]) {
+          alive[t] = 0;
+          liveTris--;
+        } else {
+          vertTris[v].push_back(t);
+        }
+      }
+      vertTris[u].clear();
+      for (size_t s = 0; s < sampled.size(); s++)
+        quadrics[v * sampled.size() + s] += quadrics[u * sampled.size() + s];
+      removed[u] = 1;
+      auto &m = members[groups[u]];
+      m.erase(std::find(m.begin(), m.end(), u));
+    }
+
+    // everything around the survivors may collapse differently now
+    std::vector<uint32> touched;
+    for (const auto &pr : pairs) {
+      auto &vt = vertTris[pr.second];
+      vt.erase(std::remove_if(vt.begin(), vt.end(), [this](uint32 t) { return !alive[t]; }), vt.end());
+      for (uint32 t : vt)
+        touched.insert(touched.end(), tris.begin() + t * 3, tris.begin() + t * 3 + 3);
+      touched.push_back(pr.second);
+    }
+    std::sort(touched.begin(), touched.end());
+    touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+    for (uint32 v : touched)
+      version[v]++;
+    for (uint32 v : touched)
+      queueEdges(v);
+  }
+
+  void queueEdges(uint32 u) {
+    neighbours.clear();
+    for (uint32 t : vertTris[u])
+      if (alive[t])
+        for (int k = 0; k < 3; k++)
+          if (tris[t * 3 + k] != u)
+            neighbours.push_back(tris[t * 3 + k]);
+    std::sort(neighbours.begin(), neighbours.end());
+    neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+
+    double worst;
+    for (uint32 v : neighbours) {
+      double cost = evaluate(u, v, queued, worst);
+      if (cost >= 0)
+        queue.push({ cost, u, v, version[u], version[v] });
+    }
+  }
+};
+
+}
+
+std::vector<Lod> buildLods(const std::vector<uint32> &indices, const std::vector<Vector3> &base,
+                           const std::vector<std::vector<Vector3>> &frames, const std::vector<uint32> &groups,
+                           const std::vector<float> &ratios, size_t maxQuadricFrames) {
+  std::vector<Lod> lods;
+  if (indices.size() < 3 || groups.empty())
+    return lods;
+
+  std::vector<float> sorted(ratios);
+  std::sort(sorted.begin(), sorted.end(), std::greater<float>());
+
+  Simplifier s(indices, base, frames, groups, maxQuadricFrames);
+  s.queueAll();
+  uint32 numTris = (uint32) (indices.size() / 3);
+  for (float ratio : sorted) {
+    s.reduce((uint32) (ratio * numTris));
+    lods.push_back({ ratio, s.error(), 0, s.indices() });
+  }
+  return lods;
+}
+
+std::vector<uint32> orderVerticesForLods(std::vector<uint32> &indices, std::vector<Lod> &lods, size_t numVertices) {
+  // band 0 holds the coarsest LOD's vertices, the last band the ones only the base mesh uses
+  uint32 numBands = (uint32) lods.size() + 1;
+  std::vector<uint32> band(numVertices, numBands);
+  std::vector<uint32> firstUse(numVertices, ~0u);
+  for (size_t i = 0; i < indices.size(); i++) {
+    band[indices[i]] = numBands - 1;
+    firstUse[indices[i]] = std::min(firstUse[indices[i]], (uint32) i);
+  }
+  for (size_t l = 0; l < lods.size(); l++)
+    for (uint32 v : lods[l].indices)
+      band[v] = std::min(band[v], (uint32) (lods.size() - 1 - l));
+
+  std::vector<uint32> order(numVertices);
+  for (uint32 v = 0; v < numVertices; v++)
+    order[v] = v;
+  std::stable_sort(order.begin(), order.end(), [&](uint32 a, uint32 b) {
+    return band[a] != band[b] ? band[a] < band[b] : firstUse[a] < firstUse[b];
+  });
+
+  std::vector<uint32> remap(numVertices);
+  for (uint32 i = 0; i < numVertices; i++)
+    remap[order[i]] = i;
+  for (auto &v : indices)
+    v = remap[v];
+  for (size_t l = 0; l < lods.size(); l++) {
+    uint32 b = (uint32) (lods.size() - 1 - l);
+    lods[l].numVertices = (uint32) std::count_if(band.begin(), band.end(), [b](uint32 x) { return x <= b; });
+    for (auto &v : lods[l].indices)
+      v = remap[v];
+  }
+  return remap;
+}
+
+}
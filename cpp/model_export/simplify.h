@@ -0,0 +1,36 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+#include "defs.h"
+#include "myvector.h"
+
+// quadric error metric simplification for animated, indexed triangle lists (three indices per triangle)
+namespace simplify {
+
+struct Lod {
+  float ratio;                  // requested fraction of the base triangles
+  float error;                  // geometric error in model units, the worst over the quadrics' frames
+  uint32 numVertices;           // set by orderVerticesForLods(), the LOD only references vertices [0, numVertices)
+  std::vector<uint32> indices;
+};
+
+// one LOD per entry of 'ratios' (largest first), built by a single sequence of half-edge collapses: a vertex
+// always collapses onto one of its neighbours, so every LOD vertex is a base vertex and per-frame positions
+// apply to all LODs unchanged. vertices with the same groups[v] share a position (UV or normal seams): they
+// only collapse along the seam, all at once, so seams don't tear; open borders only collapse along the border.
+// positions are looked up by group, base[groups[v]] and frames[f][groups[v]], so the frames are stored once
+// per position. collapses are checked for flips over the base and every frame; quadrics are only gathered
+// over at most 'maxQuadricFrames' of them, evenly spaced and the base first, which bounds their memory at
+// that many per vertex however long the animation is
+std::vector<Lod> buildLods(const std::vector<uint32> &indices, const std::vector<Vector3> &base,
+                           const std::vector<std::vector<Vector3>> &frames, const std::vector<uint32> &groups,
+                           const std::vector<float> &ratios, size_t maxQuadricFrames = 16);
+
+// renumbers vertices so that the ones each LOD references come first, coarsest LOD first, keeping the order
+// of first use in 'indices' within each band; remaps 'indices' and every LOD, sets Lod::numVertices and
+// returns remap[old] = new
+std::vector<uint32> orderVerticesForLods(std::vector<uint32> &indices, std::vector<Lod> &lods, size_t numVertices);
+
+}
@@ -0,0 +1,257 @@
+#include "streamexport.h"
+#include "obj.h"
+#include "mappedfile.h"
+#include "textscan.h"
+#include "vertexindexer.h"
+#include "normals.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace streamexport {
+
+using wavefront::Vertex;
+
+namespace {
+
+enum class Pass {
+  done,
+  needsNormals,
+  failed,
+};
+
+template<typename T>
+size_t bytesOf(const std::vector<T> &v) {
+  return v.capacity() * sizeof(T);
+}
+
+// the attributes read so far; as in any OBJ a face can only use what comes before it
+struct Pools {
+  std::vector<Vector3> coords;
+  std::vector<Vector3> nos;
+  std::vector<Vector2> uvs;
+
+  void clear() {
+    coords.clear();
+    nos.clear();
+    uvs.clear();
+  }
+
+  size_t bytes() const {
+    return bytesOf(coords) + bytesOf(nos) + bytesOf(uvs);
+  }
+
+  // scans 'v', 'vn' and 'vt' lines into the pools, returns false for any other line
+  bool scan(const char *line, const char *end) {
+    using namespace textscan;
+    if ('v' != line[0])
+      return false;
+    if (' ' == line[1]) {
+      Vector3 v;
+      const char *p = line + 2;
+      for (int i = 0; i < 3; i++)
+        p = scanFloat(skipBlanks(p, end), end, v.xyz[i]);
+      coords.push_back(v);
+      return true;
+    }
+    if ('n' == line[1]) {
+      Vector3 v;
+      const char *p = line + 2;
+      for (int i = 0; i < 3; i++)
+        p = scanFloat(skipBlanks(p, end), end, v.xyz[i]);
+      nos.push_back(v);
+      return true;
+    }
+    if ('t' == line[1]) {
+      Vector2 v;
+      const char *p = line + 2;
+      for (int i = 0; i < 2; i++)
+        p = scanFloat(skipBlanks(p, end), end, v.xy[i]);
+      uvs.push_back(v);
+      return true;
+    }
+    return false;
+  }
+};
+
+bool isFace(const char *line) {
+  return 'f' == line[0] && ' ' == line[1];
+}
+
+void scanFace(const char *line, const char *end, Vertex vs[3]) {
+  using namespace textscan;
+  const char *p = line + 2;
+  for (int i = 0; i < 3; i++)
+    p = vs[i].scan(skipBlanks(p, end), end);
+}
+
+bool validPosition(const Vertex &v, const Pools &pools) {
+  return v.vp >= 0 && v.vp < (int) pools.coords.size();
+}
+
+// sums smooth normals over every face, only the positions are kept
+bool accumulateNormals(const MappedFile &file, Pools &pools, std::vector<Vector3> &normals, Stats &stats) {
+  using namespace textscan;
+  normals::Accumulator accumulator;
+  pools.clear();
+  const char *end = file.end();
+  for (const char *line = file.begin(); line < end; line = nextLine(line, end)) {
+    if (end - line < 2)
+      break;
+    if ('v' == line[0] && ' ' == line[1]) {
+      pools.scan(line, end);
+    } else if (isFace(line)) {
+      Vertex vs[3];
+      scanFace(line, end, vs);
+      uint32 corners[3];
+      for (int i = 0; i < 3; i++) {
+        if (!validPosition(vs[i], pools)) {
+          printf("%s - '%s': face uses position %d of %zu\n", __FUNCTION__, file.name.c_str(), vs[i].vp + 1,
+                 pools.coords.size());
+          return false;
+        }
+        corners[i] = (uint32) vs[i].vp;
+      }
+      accumulator.add(pools.coords, corners);
+    }
+  }
+  size_t bytes = pools.bytes() + bytesOf(accumulator.sums) + bytesOf(accumulator.fallbacks) +
+                 bytesOf(accumulator.used);
+  stats.peakBytes = bytes > stats.peakBytes ? bytes : stats.peakBytes;
+  accumulator.finish(normals);
+  normals.resize(pools.coords.size(), Vector3(0.0f, 0.0f, 1.0f));
+  return true;
+}
+
+// appends the face lines to the vertex lines
+bool append(FILE *dst, FILE *src) {
+  std::vector<char> buffer(1 << 20);
+  rewind(src);
+  size_t n;
+  while ((n = fread(buffer.data(), 1, buffer.size(), src)) > 0) {
+    if (fwrite(buffer.data(), 1, n, dst) != n)
+      return false;
+  }
+  return !ferror(src);
+}
+
+// one pass over the file: vertex lines are written at the first use of a corner, face lines go to the
+// side file; stops with needsNormals at the first corner without 'vn' when 'generated' is null
+Pass stream(const MappedFile &file, const std::string &meshFileName, Pools &pools,
+            const std::vector<Vector3> *generated, Stats &stats) {
+  using namespace textscan;
+  const char *tag = __FUNCTION__;
+  std::string facesFileName = meshFileName + ".faces";
+  FILE *vertexFile = fopen(meshFileName.c_str(), "w");
+  FILE *faceFile = fopen(facesFileName.c_str(), "w+");
+  if (!vertexFile || !faceFile) {
+    printf("%s - can't write '%s'\n", tag, vertexFile ? facesFileName.c_str() : meshFileName.c_str());
+    if (vertexFile)
+      fclose(vertexFile);
+    if (faceFile)
+      fclose(faceFile);
+    return Pass::failed;
+  }
+
+  pools.clear();
+  VertexIndexer indexer;
+  size_t numTriangles = 0;
+  Pass result = Pass::done;
+  const char *end = file.end();
+  for (const char *line = file.begin(); line < end && Pass::done == result; line = nextLine(line, end)) {
+    if (end - line < 2)
+      break;
+    if (pools.scan(line, end) || !isFace(line))
+      continue;
+
+    Vertex vs[3];
+    scanFace(line, end, vs);
+    uint32 ids[3];
+    for (int i = 0; i < 3 && Pass::done == result; i++) {
+      const Vertex &v = vs[i];
+      if (!validPosition(v, pools) || v.vn < -1 || v.vn >= (int) pools.nos.size() || v.vt < -1 ||
+          v.vt >= (int) pools.uvs.size()) {
+        printf("%s - '%s': face corner %d/%d/%d is out of range\n", tag, file.name.c_str(), v.vp + 1, v.vt + 1,
+               v.vn + 1);
+        result = Pass::failed;
+        break;
+      }
+      if (v.vn < 0 && !generated) {
+        result = Pass::needsNormals;
+        break;
+      }
+
+      // generated normals are per position; -2 - vp keeps their keys apart from the file's own normals
+      int32 vn = v.vn >= 0 ? v.vn : -2 - v.vp;
+      size_t numBefore = indexer.size();
+      ids[i] = indexer.index(v.vp, vn, v.vt);
+      if (indexer.size() == numBefore)
+        continue;
+      const Vector3 &p = pools.coords[v.vp];
+      const Vector3 &n = v.vn >= 0 ? pools.nos[v.vn] : (*generated)[v.vp];
+      Vector2 t = v.vt >= 0 ? pools.uvs[v.vt] : Vector2();
+      fprintf(vertexFile, "v %f,%f,%f %f,%f,%f %f,%f\n", p.x, p.y, p.z, n.x, n.y, n.z, t.x, t.y);
+      stats.numGenerated += v.vn < 0 ? 1 : 0;
+    }
+    if (Pass::done != result)
+      break;
+    fprintf(faceFile, "f %u,%u,%u\n", ids[0], ids[1], ids[2]);
+    numTriangles++;
+  }
+
+  if (Pass::done == result && !append(vertexFile, faceFile)) {
+    printf("%s - failed writing '%s'\n", tag, meshFileName.c_str());
+    result = Pass::failed;
+  }
+  if (ferror(vertexFile) || ferror(faceFile))
+    result = Pass::failed;
+  fclose(vertexFile);
+  fclose(faceFile);
+  remove(facesFileName.c_str());
+
+  size_t bytes = pools.bytes() + bytesOf(indexer.keys) + bytesOf(indexer.slots) +
+                 (generated ? bytesOf(*generated) : 0);
+  stats.peakBytes = bytes > stats.peakBytes ? bytes : stats.peakBytes;
+  stats.numVertices = indexer.size();
+  stats.numTriangles = numTriangles;
+  return result;
+}
+
+}
+
+bool convert(std::string_view objFileName, std::string_view meshFileName, Stats *stats) {
+  const char *tag = __FUNCTION__;
+  MappedFile file(objFileName);
+  if (!file.valid()) {
+    printf("%s - file '%s' not found\n", tag, objFileName.data());
+    return false;
+  }
+  printf("%s - streaming '%s' to '%s'\n", tag, file.name.c_str(), meshFileName.data());
+
+  Stats local;
+  Stats &s = stats ? *stats : local;
+  s = Stats();
+  Pools pools;
+  std::string meshFile(meshFileName);
+  Pass pass = stream(file, meshFile, pools, nullptr, s);
+  if (Pass::needsNormals == pass) {
+    std::vector<Vector3> generated;
+    if (!accumulateNormals(file, pools, generated, s))
+      return false;
+    pass = stream(file, meshFile, pools, &generated, s);
+  }
+  if (Pass::done != pass) {
+    remove(meshFile.c_str());
+    return false;
+  }
+
+  printf(" * no. of vertices.: %zu\n", s.numVertices);
+  printf(" * no. of triangles: %zu\n", s.numTriangles);
+  if (s.numGenerated)
+    printf(" * generated normals for %zu vertices\n", s.numGenerated);
+  printf(" * peak memory.....: %zu KB\n", s.peakBytes / 1024);
+  return true;
+}
+
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <string_view>
+
+#include "defs.h"
+
+// OBJ -> mesh.txt for inputs too big to load: positions, normals and uvs are kept, faces are indexed and
+// written out as they are read, so memory grows with the unique vertices instead of the file
+namespace streamexport {
+
+struct Stats {
+  size_t numVertices = 0;
+  size_t numTriangles = 0;
+  size_t numGenerated = 0;  // smooth normals made for corners without 'vn'
+  size_t peakBytes = 0;     // attribute pools, indexer and normals; the mapped file isn't counted
+};
+
+// writes mesh.txt in exportBaseFromOBJ()'s format, without its weld, mesh optimization or LODs: vertices are
+// shared only by corners with the same (v, vt, vn) indices, in first use order, then the triangles. only the
+// first three corners of a face are used, as by SimpleObj. when a face has no 'vn' the file is read once more
+// to sum smooth normals (see normals::Accumulator) before any vertex is written. the faces go through
+// '<meshFileName>.faces' on disk, which is removed when done
+bool convert(std::string_view objFileName, std::string_view meshFileName, Stats *stats = nullptr);
+
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cmath>
+#include <cstring>
+#include <charconv>
+
+#include "defs.h"
+
+// in-place scanners for text held in memory (mapped files, etc.)
+// none of these allocate, copy or depend on the C locale; each returns the position
+// just past what it consumed, or 'p' unchanged if nothing could be scanned
+namespace textscan {
+
+inline bool isBlank(char c) {
+  return ' ' == c || '\t' == c;
+}
+
+inline bool isEndOfToken(char c) {
+  return ' ' == c || '\t' == c || '\r' == c || '\n' == c || '\0' == c;
+}
+
+inline bool isDigit(char c) {
+  return (unsigned) (c - '0') < 10u;
+}
+
+inline const char* skipBlanks(const char *p, const char *end) {
+  while (p < end && isBlank(*p))
+    p++;
+  return p;
+}
+
+inline const char* nextLine(const char *p, const char *end) {
+  const void *nl = memchr(p, '\n', end - p);
+  return nl ? (const char*) nl + 1 : end;
+}
+
+inline const char* scanInt(const char *p, const char *end, int &v) {
+  const char *s = p;
+  bool neg = false;
+  if (p < end && ('-' == *p || '+' == *p)) {
+    neg = '-' == *p;
+    p++;
+  }
+  const char *digits = p;
+  int64 r = 0;
+  while (p < end && isDigit(*p)) {
+    r = r * 10 + (*p - '0');
+    p++;
+  }
+  if (p == digits)
+    return s;
+  v = (int) (neg ? -r : r);
+  return p;
+}
+
+// decimal mantissas of up to 2^53 with a power of ten up to 22 are converted exactly (Clinger's
+// fast path), which covers every number an OBJ exporter writes; anything else (long mantissas,
+// inf, nan, ...) falls back to std::from_chars. either way, the result is identical to strtod()
+inline const char* scanFloat(const char *p, const char *end, float &v) {
+  static const double pow10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16,
+      1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+  const char *s = p;
+  bool neg = false;
+  if (p < end && ('-' == *p || '+' == *p)) {
+    neg = '-' == *p;
+    p++;
+  }
+  const char *number = p;
+
+  uint64 mantissa = 0;
+  int32 numDigits = 0;
+  int32 sigDigits = 0;
+  int32 exp10 = 0;
+  while (p < end && isDigit(*p)) {
+    mantissa = mantissa * 10 + (*p - '0');
+    sigDigits += (sigDigits || mantissa) ? 1 : 0;
+    numDigits++;
+    p++;
+    if (sigDigits > 19)
+      break;
+  }
+  if (p < end && '.' == *p && sigDigits <= 19) {
+    p++;
+    while (p < end && isDigit(*p)) {
+      mantissa = mantissa * 10 + (*p - '0');
+      sigDigits += (sigDigits || mantissa) ? 1 : 0;
+      numDigits++;
+      exp10--;
+      p++;
+      if (sigDigits > 19)
+        break;
+    }
+  }
+
+  if (numDigits && sigDigits <= 19 && p < end && ('e' == *p || 'E' == *p)) {
+    int e = 0;
+    const char *q = scanInt(p + 1, end, e);
+    if (q != p + 1) {
+      exp10 += e;
+      p = q;
+    }
+  }
+
+  if (numDigits && sigDigits <= 19 && mantissa <= (uint64(1) << 53) && exp10 >= -22 && exp10 <= 22) {
+    double d = (double) mantissa;
+    d = exp10 < 0 ? d / pow10[-exp10] : d * pow10[exp10];
+    v = (float) (neg ? -d : d);
+    return p;
+  }
+
+  double d = 0.0;
+  auto res = std::from_chars(number, end, d, std::chars_format::general);
+  if (res.ec == std::errc::invalid_argument)
+    return s;
+  if (res.ec == std::errc::result_out_of_range) {
+    const char *e = number;
+    while (e < res.ptr && 'e' != *e && 'E' != *e)
+      e++;
+    d = (e + 1 < res.ptr && '-' == e[1]) ? 0.0 : HUGE_VAL;
+  }
+  v = (float) (neg ? -d : d);
+  return res.ptr;
+}
+
+}
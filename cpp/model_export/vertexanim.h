@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+// binary vertex animation, written by model_export and mapped by model_loader (keep the two copies equal).
+// the frames are keyframes at increasing times, in source frames, and are blended linearly in between; the
+// clip loops, taking one source frame to get from the last back to the first. every frame has its own AABB
+// and its positions are 16-bit fractions of it, 6 bytes a vertex instead of a text line; little endian,
+// laid out as
+//
+//   Header
+//   Bounds[numFrames]
+//   float times[numFrames]
+//   uint16_t[numFrames][numVertices][3]
+//
+// the worst error is half a step, (max - min) / 131070 on each axis of the frame
+namespace vertexanim {
+
+const uint32_t magic = 'V' | 'A' << 8 | 'N' << 16 | 'M' << 24;
+const uint32_t version = 2;
+
+struct Header {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t numFrames;
+  uint32_t numVertices;
+};
+
+struct Bounds {
+  float min[3];
+  float max[3];
+};
+
+inline size_t fileSize(uint32_t numFrames, uint32_t numVertices) {
+  return sizeof(Header) + numFrames * (sizeof(Bounds) + sizeof(float)) +
+         (size_t) numFrames * numVertices * 3 * sizeof(uint16_t);
+}
+
+// bounds of 'numVertices' xyz positions
+inline Bounds bound(const float *xyz, uint32_t numVertices) {
+  Bounds b = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
+  for (uint32_t i = 0; i < numVertices; i++) {
+    for (int k = 0; k < 3; k++) {
+      float v = xyz[i * 3 + k];
+      b.min[k] = 0 == i || v < b.min[k] ? v : b.min[k];
+      b.max[k] = 0 == i || v > b.max[k] ? v : b.max[k];
+    }
+  }
+  return b;
+}
+
+inline void quantize(const Bounds &b, const float *xyz, uint32_t numVertices, uint16_t *q) {
+  float scale[3];
+  for (int k = 0; k < 3; k++)
+    scale[k] = b.max[k] > b.min[k] ? 65535.0f / (b.max[k] - b.min[k]) : 0.0f;
+  for (uint32_t i = 0; i < numVertices * 3; i++) {
+    int k = i % 3;
+    float v = (xyz[i] - b.min[k]) * scale[k];
+    v = v < 0.0f ? 0.0f : v > 65535.0f ? 65535.0f : v;
+    q[i] = (uint16_t) (v + 0.5f);
+  }
+}
+
+inline void dequantize(const Bounds &b, const uint16_t *q, uint32_t numVertices, float *xyz) {
+  float step[3];
+  for (int k = 0; k < 3; k++)
+    step[k] = (b.max[k] - b.min[k]) / 65535.0f;
+  for (uint32_t i = 0; i < numVertices; i++) {
+    xyz[i * 3 + 0] = b.min[0] + q[i * 3 + 0] * step[0];
+    xyz[i * 3 + 1] = b.min[1] + q[i * 3 + 1] * step[1];
+    xyz[i * 3 + 2] = b.min[2] + q[i * 3 + 2] * step[2];
+  }
+}
+
+// 'positions' holds numFrames x numVertices xyz triples, frame after frame, 'times' the frames' times
+inline bool write(const char *fileName, const float *positions, const float *times, uint32_t numFrames,
+                  uint32_t numVertices) {
+  FILE *fp = fopen(fileName, "wb");
+  if (!fp) {
+    printf("vertexanim: can't write '%s'\n", fileName);
+    return false;
+  }
+  Header header = { magic, version, numFrames, numVertices };
+  std::vector<Bounds> bounds(numFrames);
+  for (uint32_t f = 0; f < numFrames; f++)
+    bounds[f] = bound(positions + (size_t) f * numVertices * 3, numVertices);
+  bool ok = fwrite(&header, sizeof(header), 1, fp) == 1;
+  ok = ok && fwrite(bounds.data(), sizeof(Bounds), numFrames, fp) == numFrames;
+  ok = ok && fwrite(times, sizeof(float), numFrames, fp) == numFrames;
+  std::vector<uint16_t> q((size_t) numVertices * 3);
+  for (uint32_t f = 0; f < numFrames && ok; f++) {
+    quantize(bounds[f], positions + (size_t) f * numVertices * 3, numVertices, q.data());
+    ok = fwrite(q.data(), sizeof(uint16_t), q.size(), fp) == q.size();
+  }
+  ok = 0 == fclose(fp) && ok;
+  if (!ok)
+    printf("vertexanim: failed writing '%s'\n", fileName);
+  return ok;
+}
+
+// a file's frames in memory, e.g. mapped; nothing is copied
+struct View {
+  const Header *header = nullptr;
+  const Bounds *bounds = nullptr;
+  const float *times = nullptr;
+  const uint16_t *positions = nullptr;
+
+  // checks the header and the size, false leaves the view empty
+  bool open(const void *data, size_t size) {
+    *this = View();
+    if (!data || size < sizeof(Header))
+      return false;
+    auto h = (const Header*) data;
+    if (magic != h->magic || version != h->version || size != fileSize(h->numFrames, h->numVertices))
+      return false;
+    header = h;
+    bounds = (const Bounds*) (h + 1);
+    times = (const float*) (bounds + h->numFrames);
+    positions = (const uint16_t*) (times + h->numFrames);
+    return true;
+  }
+
+  uint32_t numFrames() const {
+    return header ? header->numFrames : 0;
+  }
+
+  uint32_t numVertices() const {
+    return header ? header->numVertices : 0;
+  }
+
+  const uint16_t* frame(uint32_t f) const {
+    return positions + (size_t) f * header->numVertices * 3;
+  }
+
+  void dequantize(uint32_t f, float *xyz) const {
+    vertexanim::dequantize(bounds[f], frame(f), header->numVertices, xyz);
+  }
+};
+
+}
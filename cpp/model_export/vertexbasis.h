@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define VERTEXBASIS_SSE 1
+#endif
+
+// vertex animation as a basis, written by model_export and mapped by model_loader (keep the two copies
+// equal): frame f is mean + sum over k of coefficients[f][k] * bases[k], with the bases the principal
+// components of the frames. a long clip needs a few bases, so it costs about (1 + numBases) frames plus a
+// handful of floats per frame. times as in vertexanim.h; little endian, laid out as
+//
+//   Header
+//   float times[numFrames]
+//   float mean[numVertices * 3]
+//   float bases[numBases][numVertices * 3]
+//   float coefficients[numFrames][numBases]
+namespace vertexbasis {
+
+const uint32_t magic = 'V' | 'P' << 8 | 'C' << 16 | 'A' << 24;
+const uint32_t version = 1;
+
+struct Header {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t numFrames;
+  uint32_t numVertices;
+  uint32_t numBases;
+  float maxError;  // worst vertex distance over every frame, in model units
+};
+
+inline size_t fileSize(uint32_t numFrames, uint32_t numVertices, uint32_t numBases) {
+  return sizeof(Header) + sizeof(float) * (numFrames + (size_t) (1 + numBases) * numVertices * 3 +
+                                           (size_t) numFrames * numBases);
+}
+
+inline bool write(const char *fileName, const Header &header, const float *times, const float *mean,
+                  const float *bases, const float *coefficients) {
+  FILE *fp = fopen(fileName, "wb");
+  if (!fp) {
+    printf("vertexbasis: can't write '%s'\n", fileName);
+    return false;
+  }
+  const size_t n = (size_t) header.numVertices * 3;
+  bool ok = fwrite(&header, sizeof(header), 1, fp) == 1;
+  ok = ok && fwrite(times, sizeof(float), header.numFrames, fp) == header.numFrames;
+  ok = ok && fwrite(mean, sizeof(float), n, fp) == n;
+  ok = ok && fwrite(bases, sizeof(float), n * header.numBases, fp) == n * header.numBases;
+  ok = ok && fwrite(coefficients, sizeof(float), (size_t) header.numFrames * header.numBases, fp) ==
+             (size_t) header.numFrames * header.numBases;
+  ok = 0 == fclose(fp) && ok;
+  if (!ok)
+    printf("vertexbasis: failed writing '%s'\n", fileName);
+  return ok;
+}
+
+// dst[i] += c[0] * b[0][i] + ... + c[3] * b[3][i] over n floats; four bases a pass so dst is read and
+// written a quarter as often
+inline void accumulate4(float *dst, const float *const b[4], const float c[4], size_t n) {
+  size_t i = 0;
+#ifdef VERTEXBASIS_SSE
+  const __m128 c0 = _mm_set1_ps(c[0]), c1 = _mm_set1_ps(c[1]), c2 = _mm_set1_ps(c[2]), c3 = _mm_set1_ps(c[3]);
+  for (; i + 4 <= n; i += 4) {
+    __m128 s = _mm_add_ps(_mm_mul_ps(c0, _mm_loadu_ps(b[0] + i)), _mm_mul_ps(c1, _mm_loadu_ps(b[1] + i)));
+    s = _mm_add_ps(s, _mm_add_ps(_mm_mul_ps(c2, _mm_loadu_ps(b[2] + i)), _mm_mul_ps(c3, _mm_loadu_ps(b[3] + i))));
+    _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), s));
+  }
+#endif
+  for (; i < n; i++)
+    dst[i] += (c[0] * b[0][i] + c[1] * b[1][i]) + (c[2] * b[2][i] + c[3] * b[3][i]);
+}
+
+inline void accumulate1(float *dst, const float *b, float c, size_t n) {
+  size_t i = 0;
+#ifdef VERTEXBASIS_SSE
+  const __m128 c0 = _mm_set1_ps(c);
+  for (; i + 4 <= n; i += 4)
+    _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(c0, _mm_loadu_ps(b + i))));
+#endif
+  for (; i < n; i++)
+    dst[i] += c * b[i];
+}
+
+// a file's basis in memory, e.g. mapped; nothing is copied
+struct View {
+  const Header *header = nullptr;
+  const float *times = nullptr;
+  const float *mean = nullptr;
+  const float *bases = nullptr;
+  const float *coefficients = nullptr;
+
+  // checks the header and the size, false leaves the view empty
+  bool open(const void *data, size_t size) {
+    *this = View();
+    if (!data || size < sizeof(Header))
+      return false;
+    auto h = (const Header*) data;
+    if (magic != h->magic || version != h->version || size != fileSize(h->numFrames, h->numVertices, h->numBases))
+      return false;
+    header = h;
+    times = (const float*) (h + 1);
+    mean = times + h->numFrames;
+    bases = mean + (size_t) h->numVertices * 3;
+    coefficients = bases + (size_t) h->numBases * h->numVertices * 3;
+    return true;
+  }
+
+  uint32_t numFrames() const {
+    return header ? header->numFrames : 0;
+  }
+
+  uint32_t numVertices() const {
+    return header ? header->numVertices : 0;
+  }
+
+  uint32_t numBases() const {
+    return header ? header->numBases : 0;
+  }
+
+  // the coefficients of frames f0 and f1 blended by s; blending them is blending the frames
+  void blend(uint32_t f0, uint32_t f1, float s, float *c) const {
+    const float *c0 = coefficients + (size_t) f0 * header->numBases;
+    const float *c1 = coefficients + (size_t) f1 * header->numBases;
+    for (uint32_t k = 0; k < header->numBases; k++)
+      c[k] = c0[k] + (c1[k] - c0[k]) * s;
+  }
+
+  // numVertices xyz positions for the coefficients c, e.g. a row of 'coefficients' or blend()'s
+  void reconstruct(const float *c, float *xyz) const {
+    const size_t n = (size_t) header->numVertices * 3;
+    const uint32_t numBases = header->numBases;
+    memcpy(xyz, mean, n * sizeof(float));
+    uint32_t k = 0;
+    for (; k + 4 <= numBases; k += 4) {
+      const float *b[4] = { bases + k * n, bases + (k + 1) * n, bases + (k + 2) * n, bases + (k + 3) * n };
+      accumulate4(xyz, b, c + k, n);
+    }
+    for (; k < numBases; k++)
+      accumulate1(xyz, bases + k * n, c[k], n);
+  }
+};
+
+}
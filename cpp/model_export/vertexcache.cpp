@@ -0,0 +1,203 @@
+#include "vertexcache.h"
+
+#include <algorithm>
+
+namespace vertexcache {
+
+namespace {
+
+// vertex -> triangles, compressed rows
+struct Adjacency {
+  std::vector<uint32> offsets;
+  std::vector<uint32> triangles;
+
+  Adjacency(const std::vector<uint32> &indices, size_t numVertices) {
+    offsets.assign(numVertices + 1, 0);
+    for (uint32 v : indices)
+      offsets[v + 1]++;
+    for (size_t v = 1; v <= numVertices; v++)
+      offsets[v] += offsets[v - 1];
+    triangles.resize(indices.size());
+    std::vector<uint32> next(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < indices.size(); i++)
+      triangles[next[indices[i]]++] = (uint32) (i / 3);
+  }
+
+  uint32 valence(uint32 v) const {
+    return offsets[v + 1] - offsets[v];
+  }
+};
+
+}
+
+float acmr(const std::vector<uint32> &indices, size_t numVertices, uint32 cacheSize) {
+  if (indices.size() < 3)
+    return 0.0f;
+
+  // a vertex is cached while fewer than 'cacheSize' misses happened since it was loaded
+  std::vector<uint32> loadedAt(numVertices, 0);
+  uint32 misses = 0;
+  for (uint32 v : indices) {
+    if (0 == loadedAt[v] || misses + 1 - loadedAt[v] > cacheSize) {
+      misses++;
+      loadedAt[v] = misses;
+    }
+  }
+  return (float) misses / (float) (indices.size() / 3);
+}
+
+void optimizeVertexCache(std::vector<uint32> &indices, size_t numVertices, uint32 cacheSize,
+                         std::vector<uint32> *clusters) {
+  size_t numTris = indices.size() / 3;
+  if (clusters)
+    clusters->clear();
+  if (!numTris)
+    return;
+
+  Adjacency adj(indices, numVertices);
+  std::vector<uint32> live(numVertices);
+  for (uint32 v = 0; v < numVertices; v++)
+    live[v] = adj.valence(v);
+
+  std::vector<uint32> cacheTime(numVertices, 0);
+  std::vector<uint8> emitted(numTris, 0);
+  std::vector<uint32> deadEnds;
+  std::vector<uint32> candidates;
+  std::vector<uint32> out;
+  out.reserve(indices.size());
+
+  uint32 time = cacheSize + 1;
+  uint32 cursor = 0;
+
+  // next vertex with live triangles: the most recent dead end, else the next one in input order
+  auto skipDeadEnd = [&]() -> int64 {
+    while (deadEnds.size()) {
+      uint32 v = deadEnds.back();
+      deadEnds.pop_back();
+      if (live[v])
+        return v;
+    }
+    while (cursor < numVertices) {
+      if (live[cursor])
+        return cursor;
+      cursor++;
+    }
+    return -1;
+  };
+
+  int64 fan = skipDeadEnd();
+  bool restart = true;
+  while (fan >= 0) {
+    if (restart && clusters)
+      clusters->push_back((uint32) (out.size() / 3));
+
+    // emit every remaining triangle around the fanning vertex
+    candidates.clear();
+    for (uint32 a = adj.offsets[fan]; a < adj.offsets[fan + 1]; a++) {
+      uint32 t = adj.triangles[a];
+      if (emitted[t])
+        continue;
+      emitted[t] = 1;
+      for (int k = 0; k < 3; k++) {
+        uint32 v = indices[t * 3 + k];
+        out.push_back(v);
+        deadEnds.push_back(v);
+        candidates.push_back(v);
+        live[v]--;
+        if (time - cacheTime[v] > cacheSize) {
+          cacheTime[v] = time;
+          time++;
+        }
+      }
+    }
+
+    // prefer the candidate that will still be in the cache once its remaining triangles are emitted,
+    // the oldest such one first; otherwise restart from a dead end
+    int64 best = -1;
+    int64 bestPriority = -1;
+    for (uint32 v : candidates) {
+      if (!live[v])
+        continue;
+      int64 priority = 0;
+      if (time - cacheTime[v] + 2 * live[v] <= cacheSize)
+        priority = time - cacheTime[v];
+      if (priority > bestPriority) {
+        bestPriority = priority;
+        best = v;
+      }
+    }
+    restart = best < 0;
+    fan = restart ? skipDeadEnd() : best;
+  }
+
+  indices.swap(out);
+}
+
+void optimizeOverdraw(std::vector<uint32> &indices, const std::vector<Vector3> &positions,
+                      const std::vector<uint32> &clusters) {
+  size_t numTris = indices.size() / 3;
+  if (clusters.size() < 2)
+    return;
+
+  struct Cluster {
+    uint32 first, count;
+    Vector3 centroid;
+    Vector3 normal;
+    float sortKey;
+  };
+
+  auto triangle = [&](size_t t, Vector3 &centroid, Vector3 &normal) {
+    const Vector3 &a = positions[indices[t * 3 + 0]];
+    const Vector3 &b = positions[indices[t * 3 + 1]];
+    const Vector3 &c = positions[indices[t * 3 + 2]];
+    normal = (b - a).cross(c - a);  // length is twice the area
+    centroid = (a + b + c) * (1.0f / 3.0f);
+    return normal.length();
+  };
+
+  Vector3 meshCentroid;
+  float meshArea = 0.0f;
+  std::vector<Cluster> sorted(clusters.size());
+  for (size_t i = 0; i < clusters.size(); i++) {
+    Cluster &c = sorted[i];
+    c.first = clusters[i];
+    c.count = (uint32) ((i + 1 < clusters.size() ? clusters[i + 1] : numTris) - c.first);
+    float area = 0.0f;
+    for (uint32 t = c.first; t < c.first + c.count; t++) {
+      Vector3 centroid, normal;
+      float a = triangle(t, centroid, normal);
+      c.centroid += centroid * a;
+      c.normal += normal;
+      area += a;
+    }
+    meshCentroid += c.centroid;
+    meshArea += area;
+    c.centroid *= area > 0.0f ? 1.0f / area : 0.0f;
+  }
+  meshCentroid *= meshArea > 0.0f ? 1.0f / meshArea : 0.0f;
+
+  for (auto &c : sorted)
+    c.sortKey = (c.centroid - meshCentroid).dot(c.normal);
+  std::stable_sort(sorted.begin(), sorted.end(), [](const Cluster &a, const Cluster &b) {
+    return a.sortKey > b.sortKey;
+  });
+
+  std::vector<uint32> out;
+  out.reserve(indices.size());
+  for (const auto &c : sorted)
+    out.insert(out.end(), indices.begin() + c.first * 3, indices.begin() + (c.first + c.count) * 3);
+  indices.swap(out);
+}
+
+std::vector<uint32> optimizeVertexFetch(std::vector<uint32> &indices, size_t numVertices) {
+  std::vector<uint32> remap(numVertices, ~0u);
+  uint32 next = 0;
+  for (auto &v : indices) {
+    if (~0u == remap[v])
+      remap[v] = next++;
+    v = remap[v];
+  }
+  return remap;
+}
+
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+#include "defs.h"
+#include "myvector.h"
+
+// triangle and vertex reordering for indexed triangle lists (three indices per triangle)
+namespace vertexcache {
+
+// average cache miss ratio (misses per triangle) of a FIFO post-transform cache of 'cacheSize' entries;
+// 0.5 is the ideal for a large regular grid, 3.0 means every corner misses
+float acmr(const std::vector<uint32> &indices, size_t numVertices, uint32 cacheSize = 16);
+
+// reorders triangles for vertex cache locality (Tipsify, Sander et al. 2007); 'clusters' receives the
+// first triangle of every run that starts at a cache dead end, usable by optimizeOverdraw()
+void optimizeVertexCache(std::vector<uint32> &indices, size_t numVertices, uint32 cacheSize = 16,
+                         std::vector<uint32> *clusters = nullptr);
+
+// reorders whole clusters so the ones facing away from the mesh center (the likely occluders) draw first;
+// triangle order inside a cluster is kept, so the cache locality of optimizeVertexCache() mostly survives
+void optimizeOverdraw(std::vector<uint32> &indices, const std::vector<Vector3> &positions,
+                      const std::vector<uint32> &clusters);
+
+// renumbers vertices in the order the indices first reference them; returns remap[old] = new
+// (~0u for unreferenced vertices), the caller reorders its vertex arrays to match
+std::vector<uint32> optimizeVertexFetch(std::vector<uint32> &indices, size_t numVertices);
+
+}
@@ -0,0 +1,188 @@
+#include "weld.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace weld {
+
+using wavefront::ColoredObj;
+using wavefront::SimpleObj;
+
+namespace {
+
+struct Cell {
+  int64 xyz[3];
+};
+
+// cells are a few epsilon wide, so most points search only their own cell; with epsilon 0 only bitwise
+// equal positions (-0 == 0) share one
+const double cellScale = 4.0;
+
+int64 cellOf(float x, double offset, float epsilon) {
+  if (epsilon > 0.0f)
+    return (int64) floor((x + offset) / (cellScale * epsilon));
+  float f = x == 0.0f ? 0.0f : x;
+  uint32 bits;
+  memcpy(&bits, &f, sizeof(bits));
+  return bits;
+}
+
+uint32 hashOf(const Cell &c) {
+  uint64 h = (uint64) c.xyz[0] * 0x9e3779b97f4a7c15ull;
+  h = (h ^ (uint64) c.xyz[1]) * 0xc2b2ae3d27d4eb4full;
+  h = (h ^ (uint64) c.xyz[2]) * 0x165667b19e3779f9ull;
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdull;
+  h ^= h >> 33;
+  return (uint32) h;
+}
+
+// in double, where the difference of two floats is exact, so it agrees with the cell ranges
+bool within(const float *a, const float *b, int n, float epsilon) {
+  for (int i = 0; i < n; i++) {
+    if (!(fabs((double) a[i] - b[i]) <= epsilon))
+      return false;
+  }
+  return true;
+}
+
+uint32 find(std::vector<uint32> &parent, uint32 i) {
+  while (parent[i] != i) {
+    parent[i] = parent[parent[i]];
+    i = parent[i];
+  }
+  return i;
+}
+
+}
+
+uint32 weld(const std::vector<ColoredObj::Vertex> &vertices, float epsilon, float attributeEpsilon,
+            std::vector<ColoredObj::Vertex> &welded, std::vector<uint32> &remap) {
+  uint32 count = (uint32) vertices.size();
+  epsilon = epsilon > 0.0f ? epsilon : 0.0f;
+
+  uint32 size = 16;
+  while (size < count * 2)
+    size <<= 1;
+  const uint32 mask = size - 1;
+  std::vector<uint32> head(size, ~0u);
+  std::vector<uint32> next(count, ~0u);
+  std::vector<Cell> cells(count);
+  std::vector<uint32> parent(count);
+
+  // every vertex within epsilon is in one of the cells the box [p - epsilon, p + epsilon] touches; buckets
+  // may hold other cells too, the distance test sorts them out
+  for (uint32 i = 0; i < count; i++) {
+    const ColoredObj::Vertex &v = vertices[i];
+    Cell lo, hi;
+    for (int k = 0; k < 3; k++) {
+      cells[i].xyz[k] = cellOf(v.p.xyz[k], 0.0, epsilon);
+      lo.xyz[k] = cellOf(v.p.xyz[k], -(double) epsilon, epsilon);
+      hi.xyz[k] = cellOf(v.p.xyz[k], epsilon, epsilon);
+    }
+    parent[i] = i;
+
+    Cell c;
+    for (c.xyz[0] = lo.xyz[0]; c.xyz[0] <= hi.xyz[0]; c.xyz[0]++)
+      for (c.xyz[1] = lo.xyz[1]; c.xyz[1] <= hi.xyz[1]; c.xyz[1]++)
+        for (c.xyz[2] = lo.xyz[2]; c.xyz[2] <= hi.xyz[2]; c.xyz[2]++) {
+          for (uint32 j = head[hashOf(c) & mask]; j != ~0u; j = next[j]) {
+            const ColoredObj::Vertex &w = vertices[j];
+            if (!within(v.p.xyz, w.p.xyz, 3, epsilon) || !within(v.n.xyz, w.n.xyz, 3, attributeEpsilon) ||
+                !within(v.t.xy, w.t.xy, 2, attributeEpsilon))
+              continue;
+            uint32 a = find(parent, i), b = find(parent, j);
+            if (a != b)
+              parent[a > b ? a : b] = a < b ? a : b;
+          }
+        }
+
+    uint32 bucket = hashOf(cells[i]) & mask;
+    next[i] = head[bucket];
+    head[bucket] = i;
+  }
+
+  // the groups are the connected components, which no visiting order changes; pick each one's smallest
+  // member and number the groups by first use
+  std::vector<uint32> smallest(count, ~0u);
+  for (uint32 i = 0; i < count; i++) {
+    uint32 r = find(parent, i);
+    if (~0u == smallest[r] || vertices[i] < vertices[smallest[r]])
+      smallest[r] = i;
+  }
+
+  welded.clear();
+  remap.resize(count);
+  std::vector<uint32> ids(count, ~0u);
+  for (uint32 i = 0; i < count; i++) {
+    uint32 r = find(parent, i);
+    if (~0u == ids[r]) {
+      ids[r] = (uint32) welded.size();
+      welded.push_back(vertices[smallest[r]]);
+    }
+    remap[i] = ids[r];
+  }
+  return count - (uint32) welded.size();
+}
+
+std::vector<uint32> twins(const SimpleObj &obj, float epsilon, float attributeEpsilon,
+                          const std::vector<wavefront::Vertex> &verts) {
+  uint32 count = (uint32) verts.size();
+  std::vector<ColoredObj::Vertex> values(count);
+  for (uint32 i = 0; i < count; i++) {
+    const auto &v = verts[i];
+    values[i] = ColoredObj::Vertex { obj.coords[v.vp], obj.nos[v.vn], obj.uvs[v.vt] };
+  }
+  std::vector<ColoredObj::Vertex> welded;
+  std::vector<uint32> remap;
+  weld(values, epsilon, attributeEpsilon, welded, remap);
+
+  // a group's triple is a member with its value
+  std::vector<uint32> kept(welded.size(), ~0u);
+  for (uint32 i = 0; i < count; i++) {
+    if (~0u == kept[remap[i]] && values[i] == welded[remap[i]])
+      kept[remap[i]] = i;
+  }
+  std::vector<uint32> into(count);
+  for (uint32 i = 0; i < count; i++)
+    into[i] = kept[remap[i]];
+  return into;
+}
+
+void split(const SimpleObj &obj, const SimpleObj &frame, float epsilon, float attributeEpsilon,
+           const std::vector<wavefront::Vertex> &verts, std::vector<uint32> &into) {
+  for (uint32 i = 0; i < (uint32) into.size(); i++) {
+    const auto &v = verts[i], &w = verts[into[i]];
+    bool same = within(frame.coords[v.vp].xyz, frame.coords[w.vp].xyz, 3, epsilon > 0.0f ? epsilon : 0.0f) &&
+                (frame.nos.size() < obj.nos.size() ||
+                 within(frame.nos[v.vn].xyz, frame.nos[w.vn].xyz, 3, attributeEpsilon));
+    into[i] = same ? into[i] : i;
+  }
+}
+
+uint32 merge(const std::vector<uint32> &into, std::vector<wavefront::Vertex> &verts, std::vector<uint32> &indices) {
+  uint32 count = (uint32) verts.size();
+  std::vector<uint32> ids(count, ~0u);
+  std::vector<wavefront::Vertex> result;
+  result.reserve(count);
+  for (auto &index : indices) {
+    uint32 i = into[index];
+    if (~0u == ids[i]) {
+      ids[i] = (uint32) result.size();
+      result.push_back(verts[i]);
+    }
+    index = ids[i];
+  }
+  verts.swap(result);
+  return count - (uint32) verts.size();
+}
+
+uint32 weld(const SimpleObj &obj, const std::vector<SimpleObj> &frames, float epsilon, float attributeEpsilon,
+            std::vector<wavefront::Vertex> &verts, std::vector<uint32> &indices) {
+  auto into = twins(obj, epsilon, attributeEpsilon, verts);
+  for (const auto &frame : frames)
+    split(obj, frame, epsilon, attributeEpsilon, verts, into);
+  return merge(into, verts, indices);
+}
+
+}
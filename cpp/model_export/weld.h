@@ -0,0 +1,35 @@
+#pragma once
+
+#include <vector>
+
+#include "defs.h"
+#include "obj.h"
+
+// merges vertices that differ only by float noise, e.g. the same corner written by two exporters
+namespace weld {
+
+// vertices whose positions are within 'epsilon' of each other on every axis and whose normals and uvs are
+// within 'attributeEpsilon' are merged, transitively; a spatial hash with cells 'epsilon' wide keeps this at
+// expected O(n). every merged group becomes its smallest member (by Vertex::operator <), so the values don't
+// depend on the input order, and 'welded' keeps the order in which the groups are first used.
+// remap[i] is the index of vertices[i] in 'welded'; returns the number of vertices merged away
+uint32 weld(const std::vector<wavefront::ColoredObj::Vertex> &vertices, float epsilon, float attributeEpsilon,
+            std::vector<wavefront::ColoredObj::Vertex> &welded, std::vector<uint32> &remap);
+
+// the same for the exporter's (vp, vn, vt) vertices of 'obj', which 'indices' index: twins are compared by
+// their values, and only merged when their positions and normals also agree in every one of 'frames', so the
+// animation is kept. each merged group becomes one of its triples; 'verts' is rebuilt in the order 'indices'
+// first uses the vertices, 'indices' is remapped. returns the number of vertices merged away
+uint32 weld(const wavefront::SimpleObj &obj, const std::vector<wavefront::SimpleObj> &frames, float epsilon,
+            float attributeEpsilon, std::vector<wavefront::Vertex> &verts, std::vector<uint32> &indices);
+
+// the same in steps, so the frames can be read one at a time: twins() compares the values in 'obj',
+// into[i] is the vertex verts[i] merges into (i when it's kept); split() keeps apart the twins 'frame' moves
+// apart; merge() rebuilds 'verts' and remaps 'indices' like weld() does
+std::vector<uint32> twins(const wavefront::SimpleObj &obj, float epsilon, float attributeEpsilon,
+                          const std::vector<wavefront::Vertex> &verts);
+void split(const wavefront::SimpleObj &obj, const wavefront::SimpleObj &frame, float epsilon, float attributeEpsilon,
+           const std::vector<wavefront::Vertex> &verts, std::vector<uint32> &into);
+uint32 merge(const std::vector<uint32> &into, std::vector<wavefront::Vertex> &verts, std::vector<uint32> &indices);
+
+}
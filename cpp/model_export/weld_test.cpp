@@ -0,0 +1,96 @@
+#include <cmath>
+#include <vector>
+
+#include "obj.h"
+#include "vertexindexer.h"
+#include "weld.h"
+#include "../check.h"
+
+using namespace wavefront;
+
+// checks the exporter's weld on a quad whose diagonal was written twice, the way exporters split a mesh
+// into parts; see ../check.h for running it
+namespace {
+
+using test::check;
+
+// two triangles, (0, 1, 2) and (3, 4, 5); 3 and 4 are twins of 2 and 1, 'noise' off them
+SimpleObj seamedQuad(float noise) {
+  SimpleObj obj;
+  obj.coords = { Vector3(0, 0, 0), Vector3(1, 0, 0), Vector3(0, 1, 0),
+                 Vector3(0, 1 + noise, 0), Vector3(1 + noise, 0, 0), Vector3(1, 1, 0) };
+  obj.nos = { Vector3(0, 0, 1) };
+  obj.uvs = { Vector2(0, 0), Vector2(1, 0), Vector2(0, 1), Vector2(1, 1) };
+  int uvs[6] = { 0, 1, 2, 2, 1, 3 };
+  for (int f = 0; f < 2; f++) {
+    Face face;
+    face.v0 = Vertex(f * 3 + 0, 0, uvs[f * 3 + 0]);
+    face.v1 = Vertex(f * 3 + 1, 0, uvs[f * 3 + 1]);
+    face.v2 = Vertex(f * 3 + 2, 0, uvs[f * 3 + 2]);
+    obj.faces.push_back(face);
+  }
+  return obj;
+}
+
+// what indexBaseAndFrames() does, with the frames in memory
+uint32 weldQuad(const SimpleObj &obj, const std::vector<SimpleObj> &frames, float epsilon,
+                std::vector<Vertex> &verts, std::vector<uint32> &indices) {
+  VertexIndexer indexer;
+  verts.clear();
+  indices.clear();
+  for (const auto &face : obj.faces) {
+    indices.push_back(indexer.index(face.v0.vp, face.v0.vn, face.v0.vt));
+    indices.push_back(indexer.index(face.v1.vp, face.v1.vn, face.v1.vt));
+    indices.push_back(indexer.index(face.v2.vp, face.v2.vn, face.v2.vt));
+  }
+  for (const auto &key : indexer.keys)
+    verts.push_back(Vertex(key.vp, key.vn, key.vt));
+  return weld::weld(obj, frames, epsilon, 0.0f, verts, indices);
+}
+
+}
+
+int main() {
+  std::vector<Vertex> verts;
+  std::vector<uint32> indices;
+
+  SimpleObj quad = seamedQuad(0.0f);
+  uint32 merged = weldQuad(quad, {}, 0.0f, verts, indices);
+  check(2 == merged && 4 == verts.size(), "exact twins merge, 6 -> 4 vertices");
+  check(6 == indices.size() && indices[3] == indices[2] && indices[4] == indices[1], "indices follow the twins");
+
+  SimpleObj noisy = seamedQuad(2e-6f);
+  weldQuad(noisy, {}, 0.0f, verts, indices);
+  check(6 == verts.size(), "noisy twins stay apart with epsilon 0");
+  weldQuad(noisy, {}, 1e-5f, verts, indices);
+  check(4 == verts.size(), "noisy twins merge within epsilon");
+
+  // a uv seam: the same corner with another uv is a vertex of its own
+  SimpleObj uvSeam = seamedQuad(0.0f);
+  uvSeam.uvs.push_back(Vector2(0.5f, 1));
+  uvSeam.faces[1].v0.vt = 4;
+  weldQuad(uvSeam, {}, 0.0f, verts, indices);
+  check(5 == verts.size(), "twins with different uvs are kept");
+
+  // a frame tearing the seam open keeps the twins apart
+  SimpleObj frame;
+  frame.coords = quad.coords;
+  frame.nos = quad.nos;
+  frame.coords[4] = Vector3(2, 0, 0);
+  weldQuad(quad, { frame }, 0.0f, verts, indices);
+  check(5 == verts.size(), "twins a frame moves apart are kept");
+
+  // every corner keeps a vertex with the values it had, within epsilon
+  weldQuad(noisy, {}, 1e-5f, verts, indices);
+  bool same = true;
+  for (size_t i = 0; i < indices.size(); i++) {
+    const Face &face = noisy.faces[i / 3];
+    const Vertex &corner = 0 == i % 3 ? face.v0 : 1 == i % 3 ? face.v1 : face.v2;
+    const Vertex &welded = verts[indices[i]];
+    Vector3 d = noisy.coords[welded.vp] - noisy.coords[corner.vp];
+    same = same && fabsf(d.x) <= 1e-5f && fabsf(d.y) <= 1e-5f && fabsf(d.z) <= 1e-5f && welded.vt == corner.vt;
+  }
+  check(same, "welded corners stay within epsilon");
+
+  return test::summary();
+}
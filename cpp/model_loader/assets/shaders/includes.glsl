@@ -44,4 +44,50 @@ layout(location = 1) in vec4 vtx_c;
 layout(location = 2) in vec4 vtx_t;
 #endif
 
+#endif
+
+
+#ifdef VTX_PACKED
+
+#ifdef __vert__
+// quantized vertex, see vertexpack.h: integers carried as exact float values, two to a component as
+// lo + hi * 65536
+layout(location = 0) in vec4 vtx_w;
+
+// the UVs' bounds, the packed uv is relative to them
+uniform float uvMinU = 0.0;
+uniform float uvMinV = 0.0;
+uniform float uvExtentU = 1.0;
+uniform float uvExtentV = 1.0;
+
+vec4 vtx_hi(){
+  return floor( vtx_w * ( 1.0 / 65536.0 ) );
+}
+
+vec4 vtx_lo(){
+  return vtx_w - vtx_hi() * 65536.0;
+}
+
+// relative to the mesh bounds, [0, 1]
+vec4 vtx_p_unpack(){
+  vec4 hi = vtx_hi();
+  vec4 lo = vtx_lo();
+  return vec4( vec3( lo.x, lo.y, hi.x + hi.y * 256.0 ) / 65535.0, 1.0 );
+}
+
+// octahedral normal
+vec3 vtx_n_unpack(){
+  vec2 o = max( ( vtx_hi().zw - 128.0 ) / 127.0, vec2( -1.0 ) );
+  vec3 n = vec3( o, 1.0 - abs( o.x ) - abs( o.y ) );
+  float t = max( -n.z, 0.0 );
+  n.xy += vec2( n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t );
+  return normalize( n );
+}
+
+vec4 vtx_t_unpack(){
+  vec2 t = vtx_lo().zw / 65535.0;
+  return vec4( uvMinU + t.x * uvExtentU, uvMinV + t.y * uvExtentV, 0.0, 0.0 );
+}
+#endif
+
 #endif
\ No newline at end of file
@@ -15,7 +15,7 @@ Depth LEqual
 **/
 
 #define TRANSFORM
-#define VTX_P_T
+#define VTX_PACKED
 #include "includes.glsl"
 
 vary vec4 var_t;
@@ -32,7 +32,7 @@ void main(){
   vec3 p2 = texelFetch( frame2, gl_VertexID ).xyz;
   p = mix( p, p2, vec3(lerpValue) );
   gl_Position = PVW * vec4(p, 1.0); //vtx_p
-  var_t = vtx_t;
+  var_t = vtx_t_unpack();
 }
 
 #endif
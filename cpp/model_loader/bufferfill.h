@@ -0,0 +1,149 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include <public/mygl.h>
+
+#include "vertexlayout.h"
+
+// batched buffer uploads: MyGL looks buffers up by name on every stream and push call, so a buffer is
+// resolved once by beginFill(), filled with bulk span copies and pushed once by commit(), e.g.
+//
+//   auto fill = bufferfill::beginFill(bufferfill::Ibo<Triangle> { "Ranger", triangles.size() });
+//   fill.write(triangles);
+//   fill.commit();
+//
+// sizes are checked per span instead of per element; every byte pushed and every push is counted in
+// bufferfill::stats
+namespace bufferfill {
+
+struct Stats {
+  uint64_t bytes = 0;
+  uint32_t uploads = 0;
+  uint32_t failures = 0;  // overflowing writes, short commits and buffers MyGL didn't create
+
+  void report(const char *tag) const {
+    printf("%s: %u uploads, %llu KB, %u failures\n", tag, uploads, (unsigned long long) (bytes / 1024), failures);
+  }
+};
+
+inline Stats stats;
+
+// buffer handles, the element type is what write() takes
+template<typename Vertex>
+struct Vbo {
+  const char *name;
+  size_t count;  // vertices
+};
+
+// T is an index or a whole primitive of them, e.g. a struct of three uint32_t
+template<typename T>
+struct Ibo {
+  const char *name;
+  size_t count;  // Ts
+};
+
+// T is a float vector with a vertexlayout::Format, one texel each
+template<typename T>
+struct Tbo {
+  const char *name;
+  size_t count;  // texels
+};
+
+template<typename T>
+class Fill {
+public:
+  Fill() = default;
+  Fill(const char *name, void *data, size_t capacity, void (*push)(const char*))
+      : name(name), data((T*) data), capacity(data ? capacity : 0), push(push) {
+    if (!data) {
+      printf("bufferfill: no stream for '%s'\n", name);
+      stats.failures++;
+    }
+  }
+
+  // appends 'count' elements, all or nothing; a fill without a stream was counted as failed by the constructor
+  bool write(const T *src, size_t count) {
+    if (!data)
+      return false;
+    if (count > capacity - written) {
+      printf("bufferfill: '%s' overflow, %zu + %zu > %zu\n", name, written, count, capacity);
+      stats.failures++;
+      return false;
+    }
+    memcpy(data + written, src, count * sizeof(T));
+    written += count;
+    return true;
+  }
+
+  bool write(const std::vector<T> &src) {
+    return write(src.data(), src.size());
+  }
+
+  // pushes the buffer once it is full; a partly written buffer isn't pushed
+  bool commit() {
+    if (!data)
+      return false;
+    if (written != capacity) {
+      printf("bufferfill: '%s' committed with %zu of %zu written\n", name, written, capacity);
+      stats.failures++;
+      return false;
+    }
+    push(name);
+    stats.bytes += capacity * sizeof(T);
+    stats.uploads++;
+    data = nullptr;
+    return true;
+  }
+
+  size_t size() const {
+    return written;
+  }
+
+private:
+  const char *name = nullptr;
+  T *data = nullptr;
+  size_t capacity = 0;
+  size_t written = 0;
+  void (*push)(const char*) = nullptr;
+};
+
+// creates the VBO with the vertex's layout
+template<typename Vertex>
+Fill<Vertex> beginFill(const Vbo<Vertex> &vbo) {
+  using L = vertexlayout::Layout<Vertex>;
+  MyGL_VertexAttrib attribs[L::count];
+  memcpy(attribs, L::attribs, sizeof(attribs));
+  MyGL_createVbo(vbo.name, (uint32_t) vbo.count, attribs, L::count);
+  return Fill<Vertex>(vbo.name, MyGL_vboStream(vbo.name).data, vbo.count, MyGL_vboPush);
+}
+
+template<typename T>
+Fill<T> beginFill(const Ibo<T> &ibo) {
+  static_assert(std::is_trivially_copyable_v<T> && sizeof(T) % sizeof(uint32_t) == 0 &&
+                alignof(T) <= alignof(uint32_t), "IBO elements must be packed 32-bit indices");
+  const size_t perT = sizeof(T) / sizeof(uint32_t);
+  MyGL_createIbo(ibo.name, (uint32_t) (ibo.count * perT));
+  return Fill<T>(ibo.name, MyGL_iboStream(ibo.name).data, ibo.count, MyGL_iboPush);
+}
+
+template<typename T>
+Fill<T> beginFill(const Tbo<T> &tbo) {
+  using F = vertexlayout::Format<T>;
+  static_assert(MYGL_VERTEX_FLOAT == F::type && sizeof(T) == F::components * sizeof(float),
+                "TBO texels must be packed float vectors");
+  MyGL_createTbo(tbo.name, (uint32_t) tbo.count, F::components);
+  return Fill<T>(tbo.name, MyGL_tboStream(tbo.name).data, tbo.count, MyGL_tboPush);
+}
+
+// rewrites a TBO beginFill() created, e.g. a frame rebuilt every step; nothing is created or reallocated
+template<typename T>
+Fill<T> refill(const Tbo<T> &tbo) {
+  return Fill<T>(tbo.name, MyGL_tboStream(tbo.name).data, tbo.count, MyGL_tboPush);
+}
+
+}
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+
+// named animation clips over the keyframes of one animation (times in source frames, see vertexanim.h).
+// load() resolves the clips to keyframe ranges and find() their names to handles, both once; from then on
+// play() and advance() only do arithmetic on what load() sized, so playback never touches the heap
+namespace clips {
+
+enum class Loop {
+  Once,      // stops on the last frame
+  Repeat,    // back to the first, taking one source frame from the last like the whole clip does
+  PingPong   // first to last and back
+};
+
+struct Clip {
+  const char *name;
+  float first, last;  // source frames, keyframes outside are left out
+  float fps;          // source frames a second
+  Loop loop;
+  float crossfade;    // seconds to fade in from the clip playing before
+};
+
+using Handle = uint32_t;
+const Handle none = ~0u;
+
+// up to four weighted keyframes, the playing clip's two and, while it fades in, the previous clip's two;
+// the weights add up to one
+struct Pose {
+  uint32_t frames[4] = { 0, 0, 0, 0 };
+  float weights[4] = { 1.0f, 0.0f, 0.0f, 0.0f };
+
+  // as the animated shader's two frames and mix() value: while fading it's the nearer keyframe of each clip,
+  // blended by the fade
+  void reduce(uint32_t out[2], float &lerp) const {
+    if (weights[2] + weights[3] <= 0.0f) {
+      out[0] = frames[0];
+      out[1] = frames[1];
+      lerp = weights[1];
+      return;
+    }
+    out[0] = weights[2] >= weights[3] ? frames[2] : frames[3];
+    out[1] = weights[0] >= weights[1] ? frames[0] : frames[1];
+    lerp = weights[0] + weights[1];
+  }
+};
+
+class Player {
+public:
+  // clips without keyframes in their range are dropped, handles are indices into what's left
+  void load(const Clip *clips_, size_t count, const float *times_, size_t numTimes) {
+    times.assign(times_, times_ + numTimes);
+    clips.clear();
+    playing = fading = State();
+    fade = 1.0f;
+    for (size_t i = 0; i < count; i++) {
+      const Clip &clip = clips_[i];
+      auto begin = std::lower_bound(times.begin(), times.end(), clip.first);
+      auto end = std::upper_bound(times.begin(), times.end(), clip.last);
+      if (begin >= end || clip.fps <= 0.0f) {
+        printf("clips: '%s' has no keyframes in [%f, %f], dropped\n", clip.name, clip.first, clip.last);
+        continue;
+      }
+      Resolved r = { clip, uint32_t(begin - times.begin()), uint32_t(end - times.begin()) - 1, 0.0f };
+      float span = times[r.last] - times[r.first];
+      r.period = Loop::Repeat == clip.loop ? span + 1.0f : Loop::PingPong == clip.loop ? 2.0f * span : span;
+      clips.push_back(r);
+    }
+  }
+
+  Handle find(const char *name) const {
+    for (size_t i = 0; i < clips.size(); i++)
+      if (0 == strcmp(clips[i].clip.name, name))
+        return Handle(i);
+    return none;
+  }
+
+  size_t size() const {
+    return clips.size();
+  }
+
+  const char* name(Handle clip) const {
+    return clip < clips.size() ? clips[clip].clip.name : "";
+  }
+
+  Handle current() const {
+    return playing.clip;
+  }
+
+  // starts 'clip' from its first frame, fading in over its crossfade from the pose of the clip playing
+  void play(Handle clip) {
+    if (clip >= clips.size() || clip == playing.clip)
+      return;
+    fading = playing;
+    playing = State { clip, 0.0f };
+    fade = fading.clip != none && clips[clip].clip.crossfade > 0.0f ? 0.0f : 1.0f;
+    update();
+  }
+
+  void advance(float seconds) {
+    if (none == playing.clip)
+      return;
+    step(playing, seconds);
+    if (fade < 1.0f) {
+      step(fading, seconds);
+      fade = std::min(1.0f, fade + seconds / clips[playing.clip].clip.crossfade);
+    }
+    update();
+  }
+
+  const Pose& pose() const {
+    return blended;
+  }
+
+private:
+  struct Resolved {
+    Clip clip;
+    uint32_t first, last;  // keyframes
+    float period;          // source frames until the clip repeats, or ends for Loop::Once
+  };
+  struct State {
+    Handle clip = none;
+    float time = 0.0f;  // source frames since the clip's first keyframe, within its period
+  };
+
+  std::vector<float> times;
+  std::vector<Resolved> clips;
+  State playing, fading;
+  float fade = 1.0f;
+  Pose blended;
+
+  void step(State &state, float seconds) const {
+    const Resolved &r = clips[state.clip];
+    state.time += seconds * r.clip.fps;
+    if (Loop::Once == r.clip.loop)
+      state.time = std::min(state.time, r.period);
+    else if (r.period > 0.0f)
+      state.time = fmodf(state.time, r.period);
+    else
+      state.time = 0.0f;
+  }
+
+  // the two keyframes around the state's time and the blend between them
+  void sample(const State &state, uint32_t frames[2], float &lerp) const {
+    const Resolved &r = clips[state.clip];
+    const float start = times[r.first];
+    const float span = times[r.last] - start;
+    float t = state.time;
+    if (Loop::PingPong == r.clip.loop && t > span)
+      t = r.period - t;
+    frames[0] = frames[1] = r.last;
+    lerp = 0.0f;
+    if (t >= span) {
+      // the way back to the first keyframe of a repeating clip
+      if (Loop::Repeat == r.clip.loop && r.last != r.first) {
+        frames[1] = r.first;
+        lerp = t - span;
+      }
+      return;
+    }
+    auto k = uint32_t(std::upper_bound(times.begin() + r.first, times.begin() + r.last + 1, start + t) -
+                      times.begin()) - 1;
+    k = std::min(k, r.last - 1);  // start + t can round up to the last time
+    frames[0] = k;
+    frames[1] = k + 1;
+    lerp = (start + t - times[k]) / (times[k + 1] - times[k]);
+  }
+
+  void update() {
+    blended = Pose();
+    if (none == playing.clip)
+      return;
+    float lerp;
+    sample(playing, blended.frames, lerp);
+    blended.weights[0] = (1.0f - lerp) * fade;
+    blended.weights[1] = lerp * fade;
+    if (fade < 1.0f) {
+      sample(fading, blended.frames + 2, lerp);
+      blended.weights[2] = (1.0f - lerp) * (1.0f - fade);
+      blended.weights[3] = lerp * (1.0f - fade);
+    }
+  }
+};
+
+}
@@ -0,0 +1,122 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <new>
+#include <atomic>
+
+#include "clips.h"
+#include "../check.h"
+
+// checks clips::Player's playback and that play() and advance() never allocate, by counting every operator
+// new; see ../check.h for running it
+std::atomic<uint64_t> allocationCount { 0 };
+
+void* operator new(size_t size) {
+  allocationCount++;
+  if (void *p = malloc(size ? size : 1))
+    return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept {
+  free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+  free(p);
+}
+
+namespace {
+
+// model_loader's clips plus one without keyframes
+const clips::Clip testClips[] = {
+  { "cycle", 1.0f, 6.0f, 5.0f, clips::Loop::Repeat, 0.0f },
+  { "sway", 3.0f, 6.0f, 3.0f, clips::Loop::PingPong, 0.4f },
+  { "settle", 1.0f, 3.0f, 2.0f, clips::Loop::Once, 0.25f },
+  { "none", 7.0f, 9.0f, 2.0f, clips::Loop::Once, 0.25f },
+};
+const float times[] = { 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f };
+const uint32_t numTimes = sizeof(times) / sizeof(times[0]);
+
+using test::check;
+
+bool valid(const clips::Pose &pose) {
+  float sum = 0.0f;
+  for (int j = 0; j < 4; j++) {
+    if (pose.frames[j] >= numTimes || pose.weights[j] < 0.0f)
+      return false;
+    sum += pose.weights[j];
+  }
+  return fabsf(sum - 1.0f) <= 1e-5f;
+}
+
+}
+
+int main() {
+  clips::Player player;
+  player.load(testClips, sizeof(testClips) / sizeof(testClips[0]), times, numTimes);
+  check(3 == player.size() && clips::none == player.find("none"), "clips without keyframes are dropped");
+
+  const uint64_t before = allocationCount;
+
+  // "cycle" against the clock model_loader's step() kept before clips: 0.1 source frames a tick, and one
+  // frame from the last keyframe back to the first
+  player.play(player.find("cycle"));
+  const float duration = times[numTimes - 1] - times[0] + 1.0f;
+  float time = 0.0f, worst = 0.0f;
+  for (int i = 0; i < 600; i++) {
+    player.advance(0.02f);
+    time = fmodf(time + 0.1f, duration);
+    uint32_t frames[2];
+    float lerp;
+    player.pose().reduce(frames, lerp);
+    float span = frames[1] > frames[0] ? times[frames[1]] - times[frames[0]] : 1.0f;
+    float played = times[frames[0]] - times[0] + lerp * span;
+    float error = fabsf(played - time);
+    worst = std::max(worst, std::min(error, duration - error));
+  }
+  check(worst <= 1e-3f, "cycle keeps the old clock");
+
+  // a crossfade holds the previous clip's keyframes until it's done
+  player.play(player.find("sway"));
+  player.advance(0.1f);
+  const clips::Pose &fading = player.pose();
+  check(fading.weights[2] + fading.weights[3] > 0.5f && valid(fading), "sway fades in over cycle");
+  player.advance(0.4f);
+  check(0.0f == player.pose().weights[2] + player.pose().weights[3], "the fade ends after its crossfade");
+
+  // ping-pong turns around on the last keyframe
+  uint32_t highest = 0, lowestAfter = numTimes;
+  for (int i = 0; i < 100; i++) {
+    player.advance(0.05f);
+    uint32_t frames[2];
+    float lerp;
+    player.pose().reduce(frames, lerp);
+    highest = std::max(highest, frames[1]);
+    if (highest == numTimes - 1)
+      lowestAfter = std::min(lowestAfter, frames[0]);
+  }
+  check(numTimes - 1 == highest && 2 == lowestAfter, "sway goes 3 -> 6 -> 3");
+
+  // once stops on its last keyframe
+  player.play(player.find("settle"));
+  for (int i = 0; i < 100; i++)
+    player.advance(0.1f);
+  check(2 == player.pose().frames[0] && 1.0f == player.pose().weights[0], "settle stops on frame 3");
+
+  // every clip into every other, mid-fade too
+  bool allValid = true;
+  for (int i = 0; i < 100000; i++) {
+    player.advance(0.013f);
+    allValid = allValid && valid(player.pose());
+    if (0 == i % 37)
+      player.play((player.current() + 1) % player.size());
+  }
+  check(allValid, "poses stay valid through clip switches");
+
+  const uint64_t allocations = allocationCount - before;
+  printf("%llu allocation(s) during playback\n", (unsigned long long) allocations);
+  check(0 == allocations, "play() and advance() don't allocate");
+
+  return test::summary();
+}
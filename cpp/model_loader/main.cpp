@@ -1,486 +1,665 @@
-#include <cstdio>
-#include <cstdlib>
-#include <cstdarg>
-#include <cstring>
-#define _USE_MATH_DEFINES
-#include <cmath>
-#include <string>
-#include <sstream>
-#include <vector>
-#include <memory>
-#include <functional>
-#include <mutex>
-
-#include <public/mygl.h>
-#include <public/vecdefs.h>
-#include <public/strn.h>
-#include <public/text.h>
-#include <mysdl2.h> // https://github.com/frabbani/mysdl2
-
-MYGLSTRNFUNCS(64)
-
-#define DISP_W 1280
-#define DISP_H 720
-
-using namespace sdl2;
-SDL sdl;
-MyGL *mygl = nullptr;
-uint32_t numPrimitives = 0;
-uint32_t maxFrames = 0;
-float yawAngle = 0.0f;
-float frameTime = 1.0f;
-uint32_t frames[2];
-
-void log(const char *str) {
-  static bool first = true;
-  static std::mutex m;
-  std::lock_guard<std::mutex> l(m);
-  if (first) {
-    printf("********************************************************\n");
-    printf("********************************************************\n");
-    printf("********************************************************\n");
-    first = false;
-  }
-  printf("%s", str);
-}
-
-struct FileData {
-  std::string name;
-  std::vector<uint8_t> data;
-  FileData() = default;
-  FileData(std::string_view fileName) {
-    FILE *fp = fopen(fileName.data(), "rb");
-    if (!fp) {
-      printf("FileData: '%s' is not a valid file\n", fileName.data());
-      return;
-    }
-    fseek(fp, 0, SEEK_END);
-    auto size = ftell(fp);
-    if (!size) {
-      printf("FileData: '%s' is empty\n", fileName.data());
-      fclose(fp);
-      return;
-    }
-    name = fileName;
-    data.reserve(size);
-    fseek(fp, 0, SEEK_SET);
-    while (!feof(fp)) {
-      data.push_back(fgetc(fp));
-    }
-    fclose(fp);
-  }
-};
-
-struct Image : public MyGL_Image {
-  Image() {
-    w = h = 0;
-    pixels = nullptr;
-  }
-  Image(uint32_t w, uint32_t h) {
-    w = h = 0;
-    pixels = nullptr;
-    if (!w || !h)
-      return;
-    auto image = MyGL_imageAlloc(w, h);
-    w = image.w;
-    h = image.h;
-    pixels = image.pixels;
-  }
-  Image(const char *bitmapFile) {
-    FileData fd(bitmapFile);
-    auto image = MyGL_imageFromBMPData(fd.data.data(), fd.data.size(), fd.name.c_str());
-    w = image.w;
-    h = image.h;
-    pixels = image.pixels;
-  }
-
-  Image(const std::vector<uint8_t> &bitmapData, const char *source = "?") {
-    auto image = MyGL_imageFromBMPData(bitmapData.data(), bitmapData.size(), source);
-    w = image.w;
-    h = image.h;
-    pixels = image.pixels;
-  }
-
-  void move(MyGL_Image *to) {
-    to->w = w;
-    to->h = h;
-    to->pixels = pixels;
-    w = h = 0;
-    pixels = nullptr;
-  }
-  ~Image() {
-    if (pixels)
-      MyGL_imageFree(static_cast<MyGL_Image*>(this));
-    w = h = 0;
-  }
-
-  MyGL_ROImage ro() {
-    return MyGL_ROImage { .w = w, .h = h, .pixels = pixels };
-  }
-};
-
-struct AsciiCharSet : public MyGL_AsciiCharSet {
-
-  AsciiCharSet(const char *name) {
-    Image(MyGL_str64Fmt("assets/fonts/%s/glyphs.bmp", name).chars).move(&imageAtlas);
-    this->name = MyGL_str64(name);
-    if (!imageAtlas.pixels) {
-      printf("failed to load font '%s' bitmap\n", name);
-      return;
-    }
-
-    numChars = 0;
-    for (int i = 0; i < MYGL_NUM_ASCII_PRINTABLE_CHARS; i++) {
-      chars[i].c = 0;
-      chars[i].x = chars[i].y = chars[i].w = chars[i].h = 0.0f;
-    }
-
-    FILE *fp = fopen(MyGL_str64Fmt("assets/fonts/%s/glyphs.txt", name).chars, "r");
-    if (!fp)
-      return;
-    char line[256];
-    while (fgets(line, sizeof(line), fp)) {
-      if (line[0] >= ' ' && line[0] <= '~') {
-        int i = numChars;
-        chars[i].c = line[0];
-        sscanf(&line[2], "%u %u %u %u", &chars[i].w, &chars[i].h, &chars[i].x, &chars[i].y);
-//        printf("'%c' %u x %u < %u , %u >\n", chars[i].c, chars[i].w, chars[i].h,
-//               chars[i].x, chars[i].y);
-        numChars++;
-      }
-    }
-    fclose(fp);
-  }
-
-  ~AsciiCharSet() {
-    MyGL_imageFree(&imageAtlas);
-    memset(this, 0, sizeof(MyGL_AsciiCharSet));
-  }
-};
-
-struct GetCharParam {
-  std::string str;
-  size_t pos = 0;
-};
-
-struct Mesh {
-  std::string name;
-  struct Vertex {
-    MyGL_Vec4 p;
-    MyGL_Vec2 t;
-  };
-  struct Triangle {
-    uint32_t i, j, k;
-  };
-  std::vector<Vertex> vertices;
-  std::vector<Triangle> triangles;
-  std::vector<std::vector<MyGL_Vec3> > animations;
-
-  Mesh(std::string name_) {
-    std::string meshFile = name_ + "/mesh.txt";
-    std::string framesFile = name_ + "/frames.txt";
-    FILE *fp = fopen(meshFile.c_str(), "r");
-    if (!fp) {
-      printf("Model: invalid mesh file '%s'\n", meshFile.c_str());
-      return;
-    }
-    name = std::move(name_);
-    size_t numVerts = 0;
-    size_t numTris = 0;
-    char line[256];
-    while (fgets(line, sizeof(line), fp)) {
-      if ('v' == line[0] && ' ' == line[1])
-        numVerts++;
-      else if ('f' == line[0] && ' ' == line[1])
-        numTris++;
-    }
-    vertices.reserve(numVerts);
-    triangles.reserve(numTris);
-    fseek(fp, 0, SEEK_SET);
-    while (fgets(line, sizeof(line), fp)) {
-      if ('v' == line[0] && ' ' == line[1]) {
-        float fs[8];
-        sscanf(&line[2], "%f,%f,%f %f,%f,%f %f,%f", &fs[0], &fs[1], &fs[2], &fs[3], &fs[4], &fs[5], &fs[6], &fs[7]);
-        Vertex v;
-        v.p = MyGL_vec4(fs[0], fs[1], fs[2], 1.0f);
-        v.t = MyGL_vec2(fs[6], fs[7]);
-        vertices.push_back(v);
-      } else if ('f' == line[0] && ' ' == line[1]) {
-        uint32_t is[3];
-        sscanf(&line[2], "%u,%u,%u", &is[0], &is[1], &is[2]);
-        triangles.push_back(Triangle { .i = is[0], .j = is[1], .k = is[2] });
-      }
-
-    }
-    fclose(fp);
-    fp = fopen(framesFile.c_str(), "r");
-    if (!fp) {
-      return;
-    }
-    int index = -1;
-    int count = 0;
-    while (fgets(line, sizeof(line), fp)) {
-      if (0 == memcmp("frame", line, 5)) {
-        index++;
-        count = 0;
-        std::vector<MyGL_Vec3> frameVertices;
-        frameVertices.reserve(vertices.size());
-        for (auto v : vertices)
-          frameVertices.push_back(MyGL_vec3(v.p.x, v.p.y, v.p.z));
-        animations.push_back(std::move(frameVertices));
-
-      } else if ('v' == line[0] && ' ' == line[1] && index >= 0) {
-        MyGL_Vec3 p, n;
-        sscanf(&line[2], "%f,%f,%f %f,%f,%f", &p.x, &p.y, &p.z, &n.x, &n.y, &n.z);
-        animations.back()[count++] = p;
-      }
-    }
-    fclose(fp);
-  }
-};
-
-char getCharCb(void *param) {
-  GetCharParam *p = (GetCharParam*) param;
-  if (p->pos >= p->str.length())
-    return '\0';
-  return p->str.c_str()[p->pos++];
-}
-
-void init() {
-  printf("*** INIT ***\n");
-
-  mygl = MyGL_initialize(log, 1, 0);
-
-  mygl->cull.on = GL_TRUE;
-  MyGL_resetCull();
-
-  mygl->depth.on = GL_TRUE;
-  MyGL_resetDepth();
-  mygl->blend.on = GL_TRUE;
-  MyGL_resetBlend();
-
-  mygl->stencil.on = GL_FALSE;
-  MyGL_resetStencil();
-
-  mygl->clearColor = MyGL_vec4Scale(MyGL_vec4(0.0757f, 0.075f, 0.122f, 1.0f), 1.5);
-  mygl->clearDepth = 1.0f;
-
-  auto makeCbParam = [=](const char *filename) {
-    FILE *fp = fopen(filename, "r");
-    std::stringstream ss;
-    char line[256];
-    while (fgets(line, sizeof(line), fp)) {
-      ss << line;
-    }
-    GetCharParam p;
-    p.str = ss.str();
-    return p;
-  };
-  printf("---------\n");
-  auto param = makeCbParam("assets/shaders/includes.glsl");
-  MyGL_loadShaderLibrary(getCharCb, &param, "includes.glsl");
-  printf("---------\n");
-  param = makeCbParam("assets/shaders/textured.shader");
-  MyGL_loadShader(getCharCb, &param, "textured.shader");
-  printf("---------\n");
-  param = makeCbParam("assets/shaders/textured_animated.shader");
-  MyGL_loadShader(getCharCb, &param, "textured_animated.shader");
-  printf("---------\n");
-  param = makeCbParam("assets/shaders/alphatextured.shader");
-  MyGL_loadShader(getCharCb, &param, "alphatextured.shader");
-  printf("---------\n");
-
-  MyGL_Debug_setChatty(GL_TRUE);
-
-  auto loadFont = [=](const char *name) {
-    AsciiCharSet charSet(name);
-    MyGL_loadAsciiCharSet(dynamic_cast<MyGL_AsciiCharSet*>(&charSet), GL_TRUE,
-    GL_TRUE);
-  };
-
-  loadFont("quake");
-  loadFont("lemonmilk");
-
-  Mesh mesh("assets/models/ranger");
-  numPrimitives = mesh.triangles.size() * 3;
-  MyGL_VertexAttrib attribs[] = { { MYGL_VERTEX_FLOAT, MYGL_XYZW, GL_FALSE }, { MYGL_VERTEX_FLOAT, MYGL_XY, GL_FALSE }, };
-  MyGL_createVbo("Ranger", mesh.vertices.size(), attribs, 2);
-  {
-    MyGL_VboStream stream = MyGL_vboStream("Ranger");
-    Mesh::Vertex *verts = (Mesh::Vertex*) stream.data;
-    int index = 0;
-    for (auto v : mesh.vertices) {
-      verts[index++] = v;
-      MyGL_vboPush("Ranger");
-    }
-  }
-  MyGL_createIbo("Ranger", mesh.triangles.size() * 3);
-  {
-    MyGL_IboStream stream = MyGL_iboStream("Ranger");
-    int index = 0;
-    for (auto t : mesh.triangles) {
-      stream.data[index++] = t.i;
-      stream.data[index++] = t.j;
-      stream.data[index++] = t.k;
-    }
-    MyGL_iboPush("Ranger");
-  }
-  if (mesh.animations.size()) {
-    maxFrames = mesh.animations.size();
-    printf("# of animations / vertices per: %zu / %zu\n", mesh.animations.size(), mesh.animations.front().size());
-    int i = 0;
-    for (const auto &frame : mesh.animations) {
-      std::string name = std::string("Ranger") + std::string("/Frame") + std::to_string(i++);
-      MyGL_createTbo(name.c_str(), mesh.vertices.size(), MYGL_XYZ);
-      auto stream = MyGL_tboStream(name.c_str());
-      int j = 0;
-      for (auto p : frame) {
-        stream.data[j++] = p.x;
-        stream.data[j++] = p.y;
-        stream.data[j++] = p.z;
-      }
-      MyGL_tboPush(name.c_str());
-    }
-  }
-
-  Image image("assets/models/ranger/skin0.bmp");
-  MyGL_createTexture2D("Ranger/Skin0", image.ro(), "rgb10a2", GL_TRUE, GL_TRUE, GL_TRUE);
-
-  MyGL_Debug_setChatty(GL_FALSE);
-
-  printf("************\n");
-
-}
-
-void step() {
-  static bool pause = false;
-  if (sdl.keyPress('p'))
-    pause = !pause;
-  if (pause)
-    return;
-
-  yawAngle -= 0.5f;
-  if (yawAngle < 0.0f)
-    yawAngle += 360.0f;
-
-  std::vector<uint32_t> frameTable;
-  for (uint32_t i = 1; i < maxFrames; i++)
-    frameTable.push_back(i);
-
-  frameTime += 0.1f;
-  float lerp = frameTime - int(frameTime);
-  frames[0] = frameTable[int(frameTime) % frameTable.size()];
-  frames[1] = frameTable[(int(frameTime) + 1) % frameTable.size()];
-
-  auto uniform = MyGL_findUniform("Vertex Position and Texture (Animated)", "Main", "lerpValue");
-  if (uniform.value && uniform.info.type == MYGL_UNIFORM_FLOAT) {
-    uniform.value->floa = lerp;
-  }
-}
-
-void draw() {
-  auto reset = []() {
-    MyGL_resetCull();
-    MyGL_resetDepth();
-    MyGL_resetBlend();
-    MyGL_resetStencil();
-    MyGL_resetColorMask();
-  };
-
-  reset();
-  MyGL_clear( GL_TRUE, GL_TRUE, GL_TRUE);
-
-  /* draw model */
-  auto transform = [&]() {
-    MyGL_Mat4 Y = MyGL_mat4Yaw(MyGL_vec3Zero, yawAngle * M_PI / 180.0f);
-    MyGL_Vec3 r = MyGL_vec3R;
-    MyGL_Vec3 l = MyGL_vec3L;
-    MyGL_Vec3 u = MyGL_vec3U;
-    l = MyGL_vec3Rotate(l, r, 90.0f * M_PI / 180.0f);
-    u = MyGL_vec3Rotate(u, r, 90.0f * M_PI / 180.0f);
-    return MyGL_mat4Multiply(Y, MyGL_mat4World(MyGL_vec3(0.0f, 0.0f, 0.0f), r, l, u));
-  };
-
-  mygl->material = MyGL_str64("Vertex Position and Texture (Animated)");
-  mygl->W_matrix = transform();
-  mygl->V_matrix = MyGL_mat4View(MyGL_vec3(0.0f, -95.0f, 8.0f), MyGL_vec3R, MyGL_vec3L, MyGL_vec3U);
-  mygl->P_matrix = MyGL_mat4Perspective((float) DISP_W / (float) DISP_H, 75.0f * 3.14159265f / 180.0f, 0.01f, 1000.0f);
-  mygl->samplers[0] = MyGL_str64("Ranger/Skin0");
-
-  mygl->samplers[1] = MyGL_str64((std::string("Ranger/Frame") + std::to_string(frames[0])).c_str());
-  mygl->samplers[2] = MyGL_str64((std::string("Ranger/Frame") + std::to_string(frames[1])).c_str());
-  MyGL_bindSamplers();
-  MyGL_drawIndexedVbo("Ranger", "Ranger", MYGL_TRIANGLES, numPrimitives);
-
-  /* write quake text */
-  mygl->material = MyGL_str64("Vertex Position and Color with Alpha Texture");
-  mygl->W_matrix = MyGL_mat4Identity;
-  mygl->V_matrix = MyGL_mat4Identity;
-  mygl->P_matrix = MyGL_mat4Ortho(5, 5, 0.01f, 1000.0f);
-  mygl->samplers[0] = MyGL_str64("quake");
-  MyGL_bindSamplers();
-  MyGL_Color color = MyGL_Color { .r = 247, .g = 211, .b = 139, .a = 255 };
-  mygl->primitive = MYGL_QUADS;
-  mygl->numPrimitives = MyGL_streamAsciiCharSet("quake", "Q RANGER Q", color, MyGL_vec3(-1.2f, 1.0f, 1.5f), MyGL_vec2(0.3f, 0.3f * DISP_W / DISP_H), 0.0f);
-  MyGL_drawStreaming("Position, Color, UV0");
-
-  /* write my info */
-  mygl->W_matrix = MyGL_mat4Identity;
-  mygl->V_matrix = MyGL_mat4Identity;
-  mygl->P_matrix = MyGL_mat4Ortho(5, 5, 0.01f, 1000.0f);
-  mygl->samplers[0] = MyGL_str64("lemonmilk");
-  MyGL_bindSamplers();
-  color.value = 0xff535b95;
-  mygl->primitive = MYGL_QUADS;
-  mygl->numPrimitives = MyGL_streamAsciiCharSet("lemonmilk", "www.youtube.com/faisal_who", color, MyGL_vec3(0.62f, 0.35f, -2.1f), MyGL_vec2(0.07f, 0.07f), 0.01f);
-  MyGL_drawStreaming("Position, Color, UV0");
-  mygl->numPrimitives = MyGL_streamAsciiCharSet("lemonmilk", "github.com/frabbani", color, MyGL_vec3(0.9f, 0.0f, -2.3f), MyGL_vec2(0.07f, 0.07f), 0.01f);
-  MyGL_drawStreaming("Position, Color, UV0");
-
-}
-
-void term() {
-  printf("*** TERM ***\n");
-  printf("************\n");
-}
-
-int main(int argc, char *args[]) {
-  setbuf( stdout, NULL);
-  if (!sdl.init( DISP_W, DISP_H, false, true))
-    return 0;
-
-  setbuf( stdout, NULL);
-
-  double drawTimeInSecs = 0.0;
-  Uint32 drawCount = 0.0;
-  double invFreq = 1.0 / sdl.getPerfFreq();
-
-  auto start = sdl.getTicks();
-  auto last = start;
-  init();
-  while (true) {
-    sdl.pump();
-    if (sdl.keyDown(SDLK_ESCAPE))
-      break;
-
-    auto now = sdl.getTicks();
-    auto elapsed = now - last;
-
-    if (elapsed >= 20) {
-      step();
-      last = (now / 20) * 20;
-    }
-    Uint64 beginCount = sdl.getPerfCounter();
-    draw();
-    drawCount++;
-    sdl.swap();
-    drawTimeInSecs += (double) (sdl.getPerfCounter() - beginCount) * invFreq;
-  }
-  term();
-  if (drawCount)
-    printf("Average draw time: %f ms\n", (float) ((drawTimeInSecs * 1e3) / (double) drawCount));
-
-  sdl.term();
-  printf("goodbye!\n");
-  return 0;
-}
+#include <cstdio>
+#include <cstdlib>
+#include <cstdarg>
+#include <cstring>
+#define _USE_MATH_DEFINES
+#include <cmath>
+#include <string>
+#include <sstream>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <algorithm>
+#include <mutex>
+
+#include <public/mygl.h>
+#include <public/vecdefs.h>
+#include <public/strn.h>
+#include <public/text.h>
+#include <mysdl2.h> // https://github.com/frabbani/mysdl2
+
+#include "vertexpack.h"
+#include "vertexlayout.h"
+#include "bufferfill.h"
+#include "mappedfile.h"
+#include "vertexanim.h"
+#include "vertexbasis.h"
+#include "morph.h"
+#include "clips.h"
+
+MYGLSTRNFUNCS(64)
+
+#define DISP_W 1280
+#define DISP_H 720
+
+using namespace sdl2;
+SDL sdl;
+MyGL *mygl = nullptr;
+float yawAngle = 0.0f;
+// the ranger's clips, over the keyframe times of frames.bin or frames.pca; 'c' plays the next one
+const clips::Clip rangerClips[] = {
+  { "cycle", 1.0f, 6.0f, 5.0f, clips::Loop::Repeat, 0.0f },
+  { "sway", 3.0f, 6.0f, 3.0f, clips::Loop::PingPong, 0.4f },
+  { "settle", 1.0f, 3.0f, 2.0f, clips::Loop::Once, 0.25f },
+};
+clips::Player player;
+uint32_t frames[2];
+std::vector<MyGL_Str64> frameSamplers;  // the frame TBOs' names, by keyframe
+// frames.pca, see vertexbasis.h: when it's there every step rebuilds the current frame into Ranger/Frame0
+MappedFile basisFile;
+vertexbasis::View basis;
+std::vector<float> basisCoefficients;
+std::vector<MyGL_Vec3> basisFrame;
+float viewDistance = 95.0f;
+
+// the base mesh and the exporter's mesh_lod<N>.txt index buffers, finest first; all share the base VBO
+struct LodLevel {
+  float error;             // geometric error in model units
+  uint32_t numPrimitives;
+  std::string ibo;
+};
+std::vector<LodLevel> lodLevels;
+// largest projected geometric error, in pixels, allowed for the LOD being drawn
+const float maxScreenError = 1.0f;
+
+void log(const char *str) {
+  static bool first = true;
+  static std::mutex m;
+  std::lock_guard<std::mutex> l(m);
+  if (first) {
+    printf("********************************************************\n");
+    printf("********************************************************\n");
+    printf("********************************************************\n");
+    first = false;
+  }
+  printf("%s", str);
+}
+
+struct FileData {
+  std::string name;
+  std::vector<uint8_t> data;
+  FileData() = default;
+  FileData(std::string_view fileName) {
+    FILE *fp = fopen(fileName.data(), "rb");
+    if (!fp) {
+      printf("FileData: '%s' is not a valid file\n", fileName.data());
+      return;
+    }
+    fseek(fp, 0, SEEK_END);
+    auto size = ftell(fp);
+    if (!size) {
+      printf("FileData: '%s' is empty\n", fileName.data());
+      fclose(fp);
+      return;
+    }
+    name = fileName;
+    data.reserve(size);
+    fseek(fp, 0, SEEK_SET);
+    while (!feof(fp)) {
+      data.push_back(fgetc(fp));
+    }
+    fclose(fp);
+  }
+};
+
+struct Image : public MyGL_Image {
+  Image() {
+    w = h = 0;
+    pixels = nullptr;
+  }
+  Image(uint32_t w, uint32_t h) {
+    w = h = 0;
+    pixels = nullptr;
+    if (!w || !h)
+      return;
+    auto image = MyGL_imageAlloc(w, h);
+    w = image.w;
+    h = image.h;
+    pixels = image.pixels;
+  }
+  Image(const char *bitmapFile) {
+    FileData fd(bitmapFile);
+    auto image = MyGL_imageFromBMPData(fd.data.data(), fd.data.size(), fd.name.c_str());
+    w = image.w;
+    h = image.h;
+    pixels = image.pixels;
+  }
+
+  Image(const std::vector<uint8_t> &bitmapData, const char *source = "?") {
+    auto image = MyGL_imageFromBMPData(bitmapData.data(), bitmapData.size(), source);
+    w = image.w;
+    h = image.h;
+    pixels = image.pixels;
+  }
+
+  void move(MyGL_Image *to) {
+    to->w = w;
+    to->h = h;
+    to->pixels = pixels;
+    w = h = 0;
+    pixels = nullptr;
+  }
+  ~Image() {
+    if (pixels)
+      MyGL_imageFree(static_cast<MyGL_Image*>(this));
+    w = h = 0;
+  }
+
+  MyGL_ROImage ro() {
+    return MyGL_ROImage { .w = w, .h = h, .pixels = pixels };
+  }
+};
+
+struct AsciiCharSet : public MyGL_AsciiCharSet {
+
+  AsciiCharSet(const char *name) {
+    Image(MyGL_str64Fmt("assets/fonts/%s/glyphs.bmp", name).chars).move(&imageAtlas);
+    this->name = MyGL_str64(name);
+    if (!imageAtlas.pixels) {
+      printf("failed to load font '%s' bitmap\n", name);
+      return;
+    }
+
+    numChars = 0;
+    for (int i = 0; i < MYGL_NUM_ASCII_PRINTABLE_CHARS; i++) {
+      chars[i].c = 0;
+      chars[i].x = chars[i].y = chars[i].w = chars[i].h = 0.0f;
+    }
+
+    FILE *fp = fopen(MyGL_str64Fmt("assets/fonts/%s/glyphs.txt", name).chars, "r");
+    if (!fp)
+      return;
+    char line[256];
+    while (fgets(line, sizeof(line), fp)) {
+      if (line[0] >= ' ' && line[0] <= '~') {
+        int i = numChars;
+        chars[i].c = line[0];
+        sscanf(&line[2], "%u %u %u %u", &chars[i].w, &chars[i].h, &chars[i].x, &chars[i].y);
+//        printf("'%c' %u x %u < %u , %u >\n", chars[i].c, chars[i].w, chars[i].h,
+//               chars[i].x, chars[i].y);
+        numChars++;
+      }
+    }
+    fclose(fp);
+  }
+
+  ~AsciiCharSet() {
+    MyGL_imageFree(&imageAtlas);
+    memset(this, 0, sizeof(MyGL_AsciiCharSet));
+  }
+};
+
+struct GetCharParam {
+  std::string str;
+  size_t pos = 0;
+};
+
+// the packed words go up as one float attribute, see vertexpack.h
+template<>
+struct vertexlayout::Format<float[4]> : vertexlayout::Format<MyGL_Vec4> {
+};
+VERTEX_LAYOUT(PackedVertex, w);
+
+struct Mesh {
+  std::string name;
+  struct Vertex {
+    MyGL_Vec4 p;
+    MyGL_Vec3 n;
+    MyGL_Vec2 t;
+  };
+  struct Triangle {
+    uint32_t i, j, k;
+  };
+  struct Lod {
+    float error;
+    std::vector<Triangle> triangles;
+  };
+  std::vector<Vertex> vertices;
+  std::vector<Triangle> triangles;
+  std::vector<Lod> lods;
+  MappedFile animationFile;  // frames.bin, see vertexanim.h
+  vertexanim::View animation;
+
+  Mesh(std::string name_) {
+    std::string meshFile = name_ + "/mesh.txt";
+    FILE *fp = fopen(meshFile.c_str(), "r");
+    if (!fp) {
+      printf("Model: invalid mesh file '%s'\n", meshFile.c_str());
+      return;
+    }
+    name = std::move(name_);
+    size_t numVerts = 0;
+    size_t numTris = 0;
+    char line[256];
+    while (fgets(line, sizeof(line), fp)) {
+      if ('v' == line[0] && ' ' == line[1])
+        numVerts++;
+      else if ('f' == line[0] && ' ' == line[1])
+        numTris++;
+    }
+    vertices.reserve(numVerts);
+    triangles.reserve(numTris);
+    fseek(fp, 0, SEEK_SET);
+    while (fgets(line, sizeof(line), fp)) {
+      if ('v' == line[0] && ' ' == line[1]) {
+        float fs[8];
+        sscanf(&line[2], "%f,%f,%f %f,%f,%f %f,%f", &fs[0], &fs[1], &fs[2], &fs[3], &fs[4], &fs[5], &fs[6], &fs[7]);
+        Vertex v;
+        v.p = MyGL_vec4(fs[0], fs[1], fs[2], 1.0f);
+        v.n = MyGL_vec3(fs[3], fs[4], fs[5]);
+        v.t = MyGL_vec2(fs[6], fs[7]);
+        vertices.push_back(v);
+      } else if ('f' == line[0] && ' ' == line[1]) {
+        uint32_t is[3];
+        sscanf(&line[2], "%u,%u,%u", &is[0], &is[1], &is[2]);
+        triangles.push_back(Triangle { .i = is[0], .j = is[1], .k = is[2] });
+      }
+
+    }
+    fclose(fp);
+
+    // LOD vertices are a prefix of the base ones, only the error and the triangles are needed
+    for (int i = 1;; i++) {
+      fp = fopen((name + "/mesh_lod" + std::to_string(i) + ".txt").c_str(), "r");
+      if (!fp)
+        break;
+      Lod lod{};
+      while (fgets(line, sizeof(line), fp)) {
+        if ('e' == line[0] && ' ' == line[1]) {
+          sscanf(&line[2], "%f", &lod.error);
+        } else if ('f' == line[0] && ' ' == line[1]) {
+          uint32_t is[3];
+          sscanf(&line[2], "%u,%u,%u", &is[0], &is[1], &is[2]);
+          lod.triangles.push_back(Triangle { .i = is[0], .j = is[1], .k = is[2] });
+        }
+      }
+      fclose(fp);
+      lods.push_back(std::move(lod));
+    }
+
+    std::string animationFileName = name + "/frames.bin";
+    if (!mapAnimation(animationFileName) && convertFrames(name + "/frames.txt", animationFileName))
+      mapAnimation(animationFileName);
+  }
+
+  bool mapAnimation(const std::string &fileName) {
+    animation = vertexanim::View();
+    if (!animationFile.open(fileName))
+      return false;
+    if (!animation.open(animationFile.data, animationFile.size) || animation.numVertices() != vertices.size()) {
+      printf("Model: '%s' doesn't match the mesh, rebuilding it\n", fileName.c_str());
+      animation = vertexanim::View();
+      animationFile.close();
+      return false;
+    }
+    return true;
+  }
+
+  // frames.txt, the text animation frames.bin replaces: a 'frame' line and then that frame's 'v p n' lines.
+  // the first frame is the bind pose mesh.txt already has and isn't played, the others become keyframes at
+  // their frame numbers; vertices a frame leaves out stay at the base position
+  bool convertFrames(const std::string &textFileName, const std::string &fileName) {
+    FILE *fp = fopen(textFileName.c_str(), "r");
+    if (!fp)
+      return false;
+    const size_t numVertices = vertices.size();
+    std::vector<float> positions;
+    std::vector<float> times;
+    int index = -1;
+    size_t count = 0;
+    auto endFrame = [&]() {
+      for (size_t i = count; index > 0 && i < numVertices; i++)
+        positions.insert(positions.end(), &vertices[i].p.x, &vertices[i].p.x + 3);
+    };
+    char line[256];
+    while (fgets(line, sizeof(line), fp)) {
+      if (0 == memcmp("frame", line, 5)) {
+        endFrame();
+        index++;
+        count = 0;
+        if (index > 0)
+          times.push_back((float) index);
+      } else if ('v' == line[0] && ' ' == line[1] && index > 0 && count < numVertices) {
+        float p[3];
+        sscanf(&line[2], "%f,%f,%f", &p[0], &p[1], &p[2]);
+        positions.insert(positions.end(), p, p + 3);
+        count++;
+      }
+    }
+    endFrame();
+    fclose(fp);
+    if (times.empty())
+      return false;
+    printf("Model: converting '%s' to '%s'\n", textFileName.c_str(), fileName.c_str());
+    return vertexanim::write(fileName.c_str(), positions.data(), times.data(), (uint32_t) times.size(),
+                             (uint32_t) numVertices);
+  }
+};
+
+char getCharCb(void *param) {
+  GetCharParam *p = (GetCharParam*) param;
+  if (p->pos >= p->str.length())
+    return '\0';
+  return p->str.c_str()[p->pos++];
+}
+
+void init() {
+  printf("*** INIT ***\n");
+
+  mygl = MyGL_initialize(log, 1, 0);
+
+  mygl->cull.on = GL_TRUE;
+  MyGL_resetCull();
+
+  mygl->depth.on = GL_TRUE;
+  MyGL_resetDepth();
+  mygl->blend.on = GL_TRUE;
+  MyGL_resetBlend();
+
+  mygl->stencil.on = GL_FALSE;
+  MyGL_resetStencil();
+
+  mygl->clearColor = MyGL_vec4Scale(MyGL_vec4(0.0757f, 0.075f, 0.122f, 1.0f), 1.5);
+  mygl->clearDepth = 1.0f;
+
+  auto makeCbParam = [=](const char *filename) {
+    FILE *fp = fopen(filename, "r");
+    std::stringstream ss;
+    char line[256];
+    while (fgets(line, sizeof(line), fp)) {
+      ss << line;
+    }
+    GetCharParam p;
+    p.str = ss.str();
+    return p;
+  };
+  printf("---------\n");
+  auto param = makeCbParam("assets/shaders/includes.glsl");
+  MyGL_loadShaderLibrary(getCharCb, &param, "includes.glsl");
+  printf("---------\n");
+  param = makeCbParam("assets/shaders/textured.shader");
+  MyGL_loadShader(getCharCb, &param, "textured.shader");
+  printf("---------\n");
+  param = makeCbParam("assets/shaders/textured_animated.shader");
+  MyGL_loadShader(getCharCb, &param, "textured_animated.shader");
+  printf("---------\n");
+  param = makeCbParam("assets/shaders/alphatextured.shader");
+  MyGL_loadShader(getCharCb, &param, "alphatextured.shader");
+  printf("---------\n");
+
+  MyGL_Debug_setChatty(GL_TRUE);
+
+  auto loadFont = [=](const char *name) {
+    AsciiCharSet charSet(name);
+    MyGL_loadAsciiCharSet(dynamic_cast<MyGL_AsciiCharSet*>(&charSet), GL_TRUE,
+    GL_TRUE);
+  };
+
+  loadFont("quake");
+  loadFont("lemonmilk");
+
+  Mesh mesh("assets/models/ranger");
+  // quantized 16 byte vertices (see vertexpack.h); the animated shader takes its positions from the frame
+  // buffers, the bounds below are the dequantization transform for anything reading the VBO position
+  VertexPacker packer;
+  for (const auto &v : mesh.vertices) {
+    packer.bound(&v.p.x);
+    packer.boundUV(&v.t.x);
+  }
+  std::vector<PackedVertex> packed;
+  packed.reserve(mesh.vertices.size());
+  for (const auto &v : mesh.vertices)
+    packed.push_back(packer.pack(&v.p.x, &v.n.x, &v.t.x));
+  {
+    auto fill = bufferfill::beginFill(bufferfill::Vbo<PackedVertex> { "Ranger", packed.size() });
+    fill.write(packed);
+    fill.commit();
+  }
+  printf("packed %zu vertices: %zu -> %zu bytes, max error: position %f, uv %f, normal %f deg\n", mesh.vertices.size(),
+         mesh.vertices.size() * (sizeof(MyGL_Vec4) + sizeof(MyGL_Vec2)), mesh.vertices.size() * sizeof(PackedVertex),
+         packer.maxPositionError, packer.maxUVError, packer.maxNormalError);
+  // the UVs' dequantization, the shader's defaults are [0, 1]
+  const char *uvNames[4] = { "uvMinU", "uvMinV", "uvExtentU", "uvExtentV" };
+  const float uvValues[4] = { packer.uvMin[0], packer.uvMin[1], packer.uvExtent(0), packer.uvExtent(1) };
+  for (int i = 0; i < 4; i++) {
+    auto uniform = MyGL_findUniform("Vertex Position and Texture (Animated)", "Main", uvNames[i]);
+    if (uniform.value && uniform.info.type == MYGL_UNIFORM_FLOAT)
+      uniform.value->floa = uvValues[i];
+  }
+  {
+    auto fill = bufferfill::beginFill(bufferfill::Ibo<Mesh::Triangle> { "Ranger", mesh.triangles.size() });
+    fill.write(mesh.triangles);
+    fill.commit();
+  }
+  lodLevels.push_back(LodLevel { 0.0f, uint32_t(mesh.triangles.size() * 3), "Ranger" });
+  for (const auto &lod : mesh.lods) {
+    std::string name = std::string("Ranger/Lod") + std::to_string(lodLevels.size());
+    auto fill = bufferfill::beginFill(bufferfill::Ibo<Mesh::Triangle> { name.c_str(), lod.triangles.size() });
+    fill.write(lod.triangles);
+    fill.commit();
+    lodLevels.push_back(LodLevel { lod.error, uint32_t(lod.triangles.size() * 3), name });
+    printf("LOD %zu: %zu triangles, error %f\n", lodLevels.size() - 1, lod.triangles.size(), lod.error);
+  }
+  // a basis for other vertices would have step() rebuild past basisFrame, it's dropped for frames.bin
+  if (!basisFile.open(mesh.name + "/frames.pca") || !basis.open(basisFile.data, basisFile.size) ||
+      basis.numVertices() != mesh.vertices.size() || mesh.vertices.empty()) {
+    basis = vertexbasis::View();
+    basisFile.close();
+  }
+  if (basis.numFrames()) {
+    player.load(rangerClips, sizeof(rangerClips) / sizeof(rangerClips[0]), basis.times, basis.numFrames());
+    frameSamplers.assign(basis.numFrames(), MyGL_str64("Ranger/Frame0"));
+    printf("# of animations / vertices per / bases: %u / %u / %u (%zu bytes mapped)\n", basis.numFrames(),
+           basis.numVertices(), basis.numBases(), basisFile.size);
+    // a single TBO, sized once and rewritten in place by step()
+    basisCoefficients.resize(basis.numBases());
+    basisFrame.resize(basis.numVertices());
+    basis.reconstruct(basis.coefficients, &basisFrame[0].x);
+    auto fill = bufferfill::beginFill(bufferfill::Tbo<MyGL_Vec3> { "Ranger/Frame0", basisFrame.size() });
+    fill.write(basisFrame);
+    fill.commit();
+  } else if (mesh.animation.numFrames()) {
+    player.load(rangerClips, sizeof(rangerClips) / sizeof(rangerClips[0]), mesh.animation.times,
+                mesh.animation.numFrames());
+    printf("# of animations / vertices per: %u / %u (%zu bytes mapped)\n", mesh.animation.numFrames(),
+           mesh.animation.numVertices(), mesh.animationFile.size);
+    // the TBOs stay float, each frame is dequantized on its way up
+    std::vector<MyGL_Vec3> frame(mesh.animation.numVertices());
+    for (uint32_t i = 0; i < mesh.animation.numFrames(); i++) {
+      std::string name = std::string("Ranger") + std::string("/Frame") + std::to_string(i);
+      mesh.animation.dequantize(i, &frame[0].x);
+      auto fill = bufferfill::beginFill(bufferfill::Tbo<MyGL_Vec3> { name.c_str(), frame.size() });
+      fill.write(frame);
+      fill.commit();
+      frameSamplers.push_back(MyGL_str64(name.c_str()));
+    }
+  }
+  if (frameSamplers.empty())
+    frameSamplers.push_back(MyGL_str64("Ranger/Frame0"));
+  player.play(player.find("cycle"));
+  for (clips::Handle i = 0; i < player.size(); i++)
+    printf("clip %u: '%s'\n", i, player.name(i));
+
+  Image image("assets/models/ranger/skin0.bmp");
+  MyGL_createTexture2D("Ranger/Skin0", image.ro(), "rgb10a2", GL_TRUE, GL_TRUE, GL_TRUE);
+
+  MyGL_Debug_setChatty(GL_FALSE);
+
+  bufferfill::stats.report("buffer uploads");
+  printf("************\n");
+
+}
+
+void step() {
+  static bool pause = false;
+  if (sdl.keyPress('p'))
+    pause = !pause;
+  if (pause)
+    return;
+
+  if (sdl.keyDown(SDLK_UP))
+    viewDistance = std::max(viewDistance - 2.0f, 20.0f);
+  if (sdl.keyDown(SDLK_DOWN))
+    viewDistance = std::min(viewDistance + 2.0f, 900.0f);
+
+  yawAngle -= 0.5f;
+  if (yawAngle < 0.0f)
+    yawAngle += 360.0f;
+
+  // the player blends the keyframes around the clip time (step() runs every 20 ms)
+  if (sdl.keyPress('c') && player.size())
+    player.play((player.current() + 1) % player.size());
+  player.advance(0.02f);
+  const clips::Pose &pose = player.pose();
+  float lerp = 0.0f;
+  pose.reduce(frames, lerp);
+
+  // with a basis the blend happens on the coefficients, all four keyframes of a crossfade included, and the
+  // shader gets the finished frame
+  if (basis.numFrames()) {
+    const uint32_t numBases = basis.numBases();
+    std::fill(basisCoefficients.begin(), basisCoefficients.end(), 0.0f);
+    for (int j = 0; j < 4; j++) {
+      const float *c = basis.coefficients + (size_t) pose.frames[j] * numBases;
+      for (uint32_t k = 0; pose.weights[j] > 0.0f && k < numBases; k++)
+        basisCoefficients[k] += pose.weights[j] * c[k];
+    }
+    basis.reconstruct(basisCoefficients.data(), &basisFrame[0].x);
+    auto fill = bufferfill::refill(bufferfill::Tbo<MyGL_Vec3> { "Ranger/Frame0", basisFrame.size() });
+    fill.write(basisFrame);
+    fill.commit();
+    frames[0] = frames[1] = 0;
+    lerp = 0.0f;
+  }
+
+  auto uniform = MyGL_findUniform("Vertex Position and Texture (Animated)", "Main", "lerpValue");
+  if (uniform.value && uniform.info.type == MYGL_UNIFORM_FLOAT) {
+    uniform.value->floa = lerp;
+  }
+}
+
+void draw() {
+  auto reset = []() {
+    MyGL_resetCull();
+    MyGL_resetDepth();
+    MyGL_resetBlend();
+    MyGL_resetStencil();
+    MyGL_resetColorMask();
+  };
+
+  reset();
+  MyGL_clear( GL_TRUE, GL_TRUE, GL_TRUE);
+
+  /* draw model */
+  auto transform = [&]() {
+    MyGL_Mat4 Y = MyGL_mat4Yaw(MyGL_vec3Zero, yawAngle * M_PI / 180.0f);
+    MyGL_Vec3 r = MyGL_vec3R;
+    MyGL_Vec3 l = MyGL_vec3L;
+    MyGL_Vec3 u = MyGL_vec3U;
+    l = MyGL_vec3Rotate(l, r, 90.0f * M_PI / 180.0f);
+    u = MyGL_vec3Rotate(u, r, 90.0f * M_PI / 180.0f);
+    return MyGL_mat4Multiply(Y, MyGL_mat4World(MyGL_vec3(0.0f, 0.0f, 0.0f), r, l, u));
+  };
+
+  // the coarsest LOD whose error projects to at most maxScreenError pixels at the model's distance
+  auto selectLod = [&](float distance, float fov) {
+    float pixelsPerUnit = (float) DISP_H / (2.0f * tanf(fov * 0.5f) * std::max(distance, 1e-3f));
+    const LodLevel *selected = &lodLevels[0];
+    for (const auto &lod : lodLevels)
+      if (lod.error * pixelsPerUnit <= maxScreenError)
+        selected = &lod;
+    return selected;
+  };
+
+  const float fov = 75.0f * 3.14159265f / 180.0f;
+  MyGL_Vec3 eye = MyGL_vec3(0.0f, -viewDistance, 8.0f);
+  mygl->material = MyGL_str64("Vertex Position and Texture (Animated)");
+  mygl->W_matrix = transform();
+  mygl->V_matrix = MyGL_mat4View(eye, MyGL_vec3R, MyGL_vec3L, MyGL_vec3U);
+  mygl->P_matrix = MyGL_mat4Perspective((float) DISP_W / (float) DISP_H, fov, 0.01f, 1000.0f);
+  mygl->samplers[0] = MyGL_str64("Ranger/Skin0");
+
+  mygl->samplers[1] = frameSamplers[std::min<size_t>(frames[0], frameSamplers.size() - 1)];
+  mygl->samplers[2] = frameSamplers[std::min<size_t>(frames[1], frameSamplers.size() - 1)];
+  MyGL_bindSamplers();
+  const LodLevel *lod = selectLod(sqrtf(eye.x * eye.x + eye.y * eye.y + eye.z * eye.z), fov);
+  MyGL_drawIndexedVbo("Ranger", lod->ibo.c_str(), MYGL_TRIANGLES, lod->numPrimitives);
+
+  /* write quake text */
+  mygl->material = MyGL_str64("Vertex Position and Color with Alpha Texture");
+  mygl->W_matrix = MyGL_mat4Identity;
+  mygl->V_matrix = MyGL_mat4Identity;
+  mygl->P_matrix = MyGL_mat4Ortho(5, 5, 0.01f, 1000.0f);
+  mygl->samplers[0] = MyGL_str64("quake");
+  MyGL_bindSamplers();
+  MyGL_Color color = MyGL_Color { .r = 247, .g = 211, .b = 139, .a = 255 };
+  mygl->primitive = MYGL_QUADS;
+  mygl->numPrimitives = MyGL_streamAsciiCharSet("quake", "Q RANGER Q", color, MyGL_vec3(-1.2f, 1.0f, 1.5f), MyGL_vec2(0.3f, 0.3f * DISP_W / DISP_H), 0.0f);
+  MyGL_drawStreaming("Position, Color, UV0");
+
+  /* write my info */
+  mygl->W_matrix = MyGL_mat4Identity;
+  mygl->V_matrix = MyGL_mat4Identity;
+  mygl->P_matrix = MyGL_mat4Ortho(5, 5, 0.01f, 1000.0f);
+  mygl->samplers[0] = MyGL_str64("lemonmilk");
+  MyGL_bindSamplers();
+  color.value = 0xff535b95;
+  mygl->primitive = MYGL_QUADS;
+  mygl->numPrimitives = MyGL_streamAsciiCharSet("lemonmilk", "www.youtube.com/faisal_who", color, MyGL_vec3(0.62f, 0.35f, -2.1f), MyGL_vec2(0.07f, 0.07f), 0.01f);
+  MyGL_drawStreaming("Position, Color, UV0");
+  mygl->numPrimitives = MyGL_streamAsciiCharSet("lemonmilk", "github.com/frabbani", color, MyGL_vec3(0.9f, 0.0f, -2.3f), MyGL_vec2(0.07f, 0.07f), 0.01f);
+  MyGL_drawStreaming("Position, Color, UV0");
+
+}
+
+void term() {
+  printf("*** TERM ***\n");
+  printf("************\n");
+}
+
+// 'model_loader -morphbench' times the CPU frame blend of morph.h, headless, and exits
+int main(int argc, char *args[]) {
+  setbuf( stdout, NULL);
+  if (argc > 1 && 0 == strcmp(args[1], "-morphbench")) {
+    morph::benchmark(16384, 2000);
+    morph::benchmark(1 << 20, 30);
+    return 0;
+  }
+  if (!sdl.init( DISP_W, DISP_H, false, true))
+    return 0;
+
+  setbuf( stdout, NULL);
+
+  double drawTimeInSecs = 0.0;
+  Uint32 drawCount = 0.0;
+  double invFreq = 1.0 / sdl.getPerfFreq();
+
+  auto start = sdl.getTicks();
+  auto last = start;
+  init();
+  while (true) {
+    sdl.pump();
+    if (sdl.keyDown(SDLK_ESCAPE))
+      break;
+
+    auto now = sdl.getTicks();
+    auto elapsed = now - last;
+
+    if (elapsed >= 20) {
+      step();
+      last = (now / 20) * 20;
+    }
+    Uint64 beginCount = sdl.getPerfCounter();
+    draw();
+    drawCount++;
+    sdl.swap();
+    drawTimeInSecs += (double) (sdl.getPerfCounter() - beginCount) * invFreq;
+  }
+  term();
+  if (drawCount)
+    printf("Average draw time: %f ms\n", (float) ((drawTimeInSecs * 1e3) / (double) drawCount));
+
+  sdl.term();
+  printf("goodbye!\n");
+  return 0;
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstdio>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+// read-only view of an entire file, mapped into memory (no copies, no per-line syscalls)
+struct MappedFile {
+  std::string name;
+  const char *data = nullptr;
+  size_t size = 0;
+
+  MappedFile() = default;
+  MappedFile(std::string_view fileName) {
+    open(fileName);
+  }
+  ~MappedFile() {
+    close();
+  }
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator =(const MappedFile&) = delete;
+
+  bool valid() const {
+    return data != nullptr;
+  }
+
+  const char* begin() const {
+    return data;
+  }
+
+  const char* end() const {
+    return data + size;
+  }
+
+  bool open(std::string_view fileName) {
+    close();
+    std::string file(fileName);
+#ifdef _WIN32
+    HANDLE fh = CreateFileA(file.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (fh == INVALID_HANDLE_VALUE)
+      return false;
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(fh, &fileSize) || 0 == fileSize.QuadPart) {
+      CloseHandle(fh);
+      return false;
+    }
+    HANDLE mh = CreateFileMappingA(fh, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(fh);
+    if (!mh)
+      return false;
+    void *p = MapViewOfFile(mh, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mh);
+    if (!p)
+      return false;
+    size = (size_t) fileSize.QuadPart;
+#else
+    int fd = ::open(file.c_str(), O_RDONLY);
+    if (fd < 0)
+      return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || 0 == st.st_size) {
+      ::close(fd);
+      return false;
+    }
+    void *p = mmap(nullptr, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (MAP_FAILED == p)
+      return false;
+    size = (size_t) st.st_size;
+    madvise(p, size, MADV_SEQUENTIAL);
+#endif
+    data = (const char*) p;
+    name = std::move(file);
+    return true;
+  }
+
+  void close() {
+    if (data) {
+#ifdef _WIN32
+      UnmapViewOfFile(data);
+#else
+      munmap((void*) data, size);
+#endif
+    }
+    data = nullptr;
+    size = 0;
+    name.clear();
+  }
+};
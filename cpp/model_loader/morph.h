@@ -0,0 +1,242 @@
+#pragma once
+
+#include <cstdio>
+#include <cstddef>
+#include <chrono>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define MORPH_AVX2 1
+#endif
+
+// the animated shader's frame blend on the CPU, for the animated pose off the GPU: headless processing,
+// bounds, picking. positions are SoA, one array per axis, so every kernel is a plain loop over floats and
+// the axes are just three calls. the AVX2 kernels are built when the compiler targets AVX2 (-mavx2,
+// /arch:AVX2); otherwise, and for the tails, the scalar ones run. lerp() is the shader's mix(a, b, s)
+namespace morph {
+
+struct Soa {
+  std::vector<float> x, y, z;
+
+  size_t size() const {
+    return x.size();
+  }
+
+  void resize(size_t n) {
+    x.resize(n);
+    y.resize(n);
+    z.resize(n);
+  }
+
+  // from and to xyz triples, e.g. a vertexanim frame or a TBO
+  void fromXyz(const float *xyz, size_t n) {
+    resize(n);
+    for (size_t i = 0; i < n; i++) {
+      x[i] = xyz[i * 3 + 0];
+      y[i] = xyz[i * 3 + 1];
+      z[i] = xyz[i * 3 + 2];
+    }
+  }
+
+  void toXyz(float *xyz) const {
+    for (size_t i = 0; i < size(); i++) {
+      xyz[i * 3 + 0] = x[i];
+      xyz[i * 3 + 1] = y[i];
+      xyz[i * 3 + 2] = z[i];
+    }
+  }
+};
+
+// dst[i] = a[i] + (b[i] - a[i]) * s
+inline void lerpScalar(const float *a, const float *b, float s, float *dst, size_t n) {
+  for (size_t i = 0; i < n; i++)
+    dst[i] = a[i] + (b[i] - a[i]) * s;
+}
+
+// dst[i] = w[0] * src[0][i] + ... + w[k - 1] * src[k - 1][i]
+inline void weighScalar(const float *const *src, const float *w, size_t k, float *dst, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    float sum = 0.0f;
+    for (size_t j = 0; j < k; j++)
+      sum += w[j] * src[j][i];
+    dst[i] = sum;
+  }
+}
+
+#ifdef MORPH_AVX2
+inline void lerpAvx2(const float *a, const float *b, float s, float *dst, size_t n) {
+  const __m256 s8 = _mm256_set1_ps(s);
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256 a8 = _mm256_loadu_ps(a + i);
+    __m256 d8 = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(b + i), a8), s8);
+    _mm256_storeu_ps(dst + i, _mm256_add_ps(a8, d8));
+  }
+  lerpScalar(a + i, b + i, s, dst + i, n - i);
+}
+
+// eight vertices at a time through every frame, so dst is written once
+inline void weighAvx2(const float *const *src, const float *w, size_t k, float *dst, size_t n) {
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256 sum = _mm256_setzero_ps();
+    for (size_t j = 0; j < k; j++)
+      sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_set1_ps(w[j]), _mm256_loadu_ps(src[j] + i)));
+    _mm256_storeu_ps(dst + i, sum);
+  }
+  for (; i < n; i++) {
+    float sum = 0.0f;
+    for (size_t j = 0; j < k; j++)
+      sum += w[j] * src[j][i];
+    dst[i] = sum;
+  }
+}
+#endif
+
+inline void lerp(const float *a, const float *b, float s, float *dst, size_t n) {
+#ifdef MORPH_AVX2
+  lerpAvx2(a, b, s, dst, n);
+#else
+  lerpScalar(a, b, s, dst, n);
+#endif
+}
+
+inline void weigh(const float *const *src, const float *w, size_t k, float *dst, size_t n) {
+#ifdef MORPH_AVX2
+  weighAvx2(src, w, k, dst, n);
+#else
+  weighScalar(src, w, k, dst, n);
+#endif
+}
+
+// two frames, the shader's blend; dst must have a's size
+inline void lerp(const Soa &a, const Soa &b, float s, Soa &dst) {
+  lerp(a.x.data(), b.x.data(), s, dst.x.data(), a.size());
+  lerp(a.y.data(), b.y.data(), s, dst.y.data(), a.size());
+  lerp(a.z.data(), b.z.data(), s, dst.z.data(), a.size());
+}
+
+// any number of frames by weight, e.g. a crossfade of two clips' blends; at most 16 frames
+inline bool blend(const Soa *const *frames, const float *weights, size_t k, Soa &dst) {
+  const size_t maxFrames = 16;
+  if (0 == k || k > maxFrames)
+    return false;
+  const float *x[maxFrames], *y[maxFrames], *z[maxFrames];
+  for (size_t j = 0; j < k; j++) {
+    x[j] = frames[j]->x.data();
+    y[j] = frames[j]->y.data();
+    z[j] = frames[j]->z.data();
+  }
+  weigh(x, weights, k, dst.x.data(), dst.size());
+  weigh(y, weights, k, dst.y.data(), dst.size());
+  weigh(z, weights, k, dst.z.data(), dst.size());
+  return true;
+}
+
+// AABB of the pose, false when it's empty
+inline bool bound(const Soa &p, float min[3], float max[3]) {
+  if (!p.size())
+    return false;
+  const float *axes[3] = { p.x.data(), p.y.data(), p.z.data() };
+  for (int k = 0; k < 3; k++) {
+    const float *a = axes[k];
+    size_t i = 0;
+    float lo = a[0], hi = a[0];
+#ifdef MORPH_AVX2
+    if (p.size() >= 8) {
+      __m256 lo8 = _mm256_loadu_ps(a), hi8 = lo8;
+      for (i = 8; i + 8 <= p.size(); i += 8) {
+        __m256 a8 = _mm256_loadu_ps(a + i);
+        lo8 = _mm256_min_ps(lo8, a8);
+        hi8 = _mm256_max_ps(hi8, a8);
+      }
+      float los[8], his[8];
+      _mm256_storeu_ps(los, lo8);
+      _mm256_storeu_ps(his, hi8);
+      for (int j = 0; j < 8; j++) {
+        lo = los[j] < lo ? los[j] : lo;
+        hi = his[j] > hi ? his[j] : hi;
+      }
+    }
+#endif
+    for (; i < p.size(); i++) {
+      lo = a[i] < lo ? a[i] : lo;
+      hi = a[i] > hi ? a[i] : hi;
+    }
+    min[k] = lo;
+    max[k] = hi;
+  }
+  return true;
+}
+
+// vertices per second on this core, scalar loop against the built kernel, for the two-frame blend and a
+// four-frame weighted one; the frames are synthetic
+inline void benchmark(size_t numVertices, int repeats) {
+  using Clock = std::chrono::steady_clock;
+  const size_t numFrames = 4;
+  std::vector<Soa> frames(numFrames);
+  for (size_t f = 0; f < numFrames; f++) {
+    frames[f].resize(numVertices);
+    for (size_t i = 0; i < numVertices; i++) {
+      frames[f].x[i] = (float) (i % 977) * 0.01f + f;
+      frames[f].y[i] = (float) (i % 613) * 0.02f - f;
+      frames[f].z[i] = (float) (i % 331) * 0.03f;
+    }
+  }
+  const Soa *sources[numFrames] = { &frames[0], &frames[1], &frames[2], &frames[3] };
+  const float weights[numFrames] = { 0.4f, 0.3f, 0.2f, 0.1f };
+  Soa dst;
+  dst.resize(numVertices);
+
+  auto rate = [&](auto kernel) {
+    kernel(0);
+    auto start = Clock::now();
+    for (int r = 0; r < repeats; r++)
+      kernel(r);
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return seconds > 0.0 ? (double) numVertices * repeats / seconds : 0.0;
+  };
+  auto lerpWith = [&](auto lerp1) {
+    return [&, lerp1](int r) {
+      float s = (float) (r % 64) / 64.0f;
+      lerp1(frames[0].x.data(), frames[1].x.data(), s, dst.x.data(), numVertices);
+      lerp1(frames[0].y.data(), frames[1].y.data(), s, dst.y.data(), numVertices);
+      lerp1(frames[0].z.data(), frames[1].z.data(), s, dst.z.data(), numVertices);
+    };
+  };
+  auto weighWith = [&](auto weigh1) {
+    return [&, weigh1](int) {
+      const float *x[numFrames], *y[numFrames], *z[numFrames];
+      for (size_t j = 0; j < numFrames; j++) {
+        x[j] = sources[j]->x.data();
+        y[j] = sources[j]->y.data();
+        z[j] = sources[j]->z.data();
+      }
+      weigh1(x, weights, numFrames, dst.x.data(), numVertices);
+      weigh1(y, weights, numFrames, dst.y.data(), numVertices);
+      weigh1(z, weights, numFrames, dst.z.data(), numVertices);
+    };
+  };
+
+  printf("morph benchmark, %zu vertices x %d:\n", numVertices, repeats);
+  double lerpScalarRate = rate(lerpWith(lerpScalar));
+  double weighScalarRate = rate(weighWith(weighScalar));
+#ifdef MORPH_AVX2
+  double lerpAvx2Rate = rate(lerpWith(lerpAvx2));
+  double weighAvx2Rate = rate(weighWith(weighAvx2));
+  printf(" * lerp, 2 frames...: scalar %.1f, AVX2 %.1f Mvertices/s (%.2fx)\n", lerpScalarRate * 1e-6,
+         lerpAvx2Rate * 1e-6, lerpAvx2Rate / lerpScalarRate);
+  printf(" * weigh, %zu frames.: scalar %.1f, AVX2 %.1f Mvertices/s (%.2fx)\n", numFrames, weighScalarRate * 1e-6,
+         weighAvx2Rate * 1e-6, weighAvx2Rate / weighScalarRate);
+#else
+  printf(" * lerp, 2 frames...: scalar %.1f Mvertices/s (AVX2 not built, compile with -mavx2)\n",
+         lerpScalarRate * 1e-6);
+  printf(" * weigh, %zu frames.: scalar %.1f Mvertices/s\n", numFrames, weighScalarRate * 1e-6);
+#endif
+  float min[3], max[3];
+  bound(dst, min, max);
+  printf(" * bounds...........: (%f, %f, %f) - (%f, %f, %f)\n", min[0], min[1], min[2], max[0], max[1], max[2]);
+}
+
+}
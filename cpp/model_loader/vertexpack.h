@@ -0,0 +1,150 @@
+#pragma once
+
+#include <cstdint>
+#include <cmath>
+
+// 16 byte quantized vertex: 16-bit positions relative to the mesh bounds, 16-bit UVs relative to the UV bounds
+// and an 8:8 octahedral normal. MyGL's vertex attributes are floats, so the integers are carried as float
+// values, two per word: lo + hi * 65536 stays below 2^24 and every float up there is exact. the shader splits
+// them with floor(), see VTX_PACKED in assets/shaders/includes.glsl. w[0] = x | z & 0xff, w[1] = y | z >> 8,
+// w[2] = u | normal x, w[3] = v | normal y, the normal as snorm8 + 128
+struct PackedVertex {
+  float w[4];
+};
+
+static_assert(sizeof(PackedVertex) == 16, "PackedVertex must stay 16 bytes, tightly packed");
+
+struct VertexPacker {
+  float min[3] = { 0.0f, 0.0f, 0.0f };
+  float max[3] = { 0.0f, 0.0f, 0.0f };
+  bool bounded = false;
+  float uvMin[2] = { 0.0f, 0.0f };
+  float uvMax[2] = { 0.0f, 0.0f };
+  bool uvBounded = false;
+
+  // largest round trip errors seen by pack(), in mesh units, UV units and degrees
+  float maxPositionError = 0.0f;
+  float maxUVError = 0.0f;
+  float maxNormalError = 0.0f;
+
+  static uint16_t quantizeUnorm16(float v) {
+    v = v < 0.0f ? 0.0f : v > 1.0f ? 1.0f : v;
+    return (uint16_t) (v * 65535.0f + 0.5f);
+  }
+
+  static float dequantizeUnorm16(uint16_t q) {
+    return (float) q / 65535.0f;
+  }
+
+  static int8_t quantizeSnorm8(float v) {
+    v = v < -1.0f ? -1.0f : v > 1.0f ? 1.0f : v;
+    return (int8_t) lroundf(v * 127.0f);
+  }
+
+  // as the shader decodes it
+  static float dequantizeSnorm8(int8_t q) {
+    float v = (float) q / 127.0f;
+    return v < -1.0f ? -1.0f : v;
+  }
+
+  // octahedral encoding (Cigolle et al. 2014)
+  static void packOctahedral(float x, float y, float z, int8_t o[2]) {
+    o[0] = o[1] = 0;
+    float l1 = fabsf(x) + fabsf(y) + fabsf(z);
+    if (l1 <= 0.0f)
+      return;
+    x /= l1;
+    y /= l1;
+    if (z < 0.0f) {
+      float ox = (1.0f - fabsf(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+      float oy = (1.0f - fabsf(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+      x = ox;
+      y = oy;
+    }
+    o[0] = quantizeSnorm8(x);
+    o[1] = quantizeSnorm8(y);
+  }
+
+  static void unpackOctahedral(const int8_t o[2], float n[3]) {
+    n[0] = dequantizeSnorm8(o[0]);
+    n[1] = dequantizeSnorm8(o[1]);
+    n[2] = 1.0f - fabsf(n[0]) - fabsf(n[1]);
+    float t = n[2] < 0.0f ? -n[2] : 0.0f;
+    n[0] += n[0] >= 0.0f ? -t : t;
+    n[1] += n[1] >= 0.0f ? -t : t;
+    float l = sqrtf(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+    for (int i = 0; i < 3; i++)
+      n[i] /= l;
+  }
+
+  // dequantization: p = min + unorm * extent, uv = uvMin + unorm * uvExtent
+  float extent(int i) const {
+    return max[i] - min[i];
+  }
+
+  float uvExtent(int i) const {
+    return uvMax[i] - uvMin[i];
+  }
+
+  static float word(uint32_t lo, uint32_t hi) {
+    return (float) (lo | hi << 16);
+  }
+
+  // grows the bounds by 'p', call for every position before the first pack()
+  void bound(const float *p) {
+    for (int i = 0; i < 3; i++) {
+      min[i] = !bounded || p[i] < min[i] ? p[i] : min[i];
+      max[i] = !bounded || p[i] > max[i] ? p[i] : max[i];
+    }
+    bounded = true;
+  }
+
+  // grows the UV bounds by 't', call for every UV before the first pack(); tiled UVs keep their range
+  void boundUV(const float *t) {
+    for (int i = 0; i < 2; i++) {
+      uvMin[i] = !uvBounded || t[i] < uvMin[i] ? t[i] : uvMin[i];
+      uvMax[i] = !uvBounded || t[i] > uvMax[i] ? t[i] : uvMax[i];
+    }
+    uvBounded = true;
+  }
+
+  // 'n' and 't' may be null
+  PackedVertex pack(const float *p, const float *n, const float *t) {
+    uint16_t q[3];
+    for (int i = 0; i < 3; i++) {
+      float e = extent(i);
+      q[i] = quantizeUnorm16(e > 0.0f ? (p[i] - min[i]) / e : 0.0f);
+      e = fabsf(min[i] + dequantizeUnorm16(q[i]) * e - p[i]);
+      maxPositionError = e > maxPositionError ? e : maxPositionError;
+    }
+
+    int8_t o[2] = { 0, 0 };
+    if (n) {
+      float l = sqrtf(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+      packOctahedral(n[0], n[1], n[2], o);
+      if (l > 0.0f) {
+        float d[3];
+        unpackOctahedral(o, d);
+        float c = (d[0] * n[0] + d[1] * n[1] + d[2] * n[2]) / l;
+        c = c > 1.0f ? 1.0f : c < -1.0f ? -1.0f : c;
+        float e = acosf(c) * 57.2957795f;
+        maxNormalError = e > maxNormalError ? e : maxNormalError;
+      }
+    }
+
+    uint16_t uv[2] = { 0, 0 };
+    for (int i = 0; t && i < 2; i++) {
+      float e = uvExtent(i);
+      uv[i] = quantizeUnorm16(e > 0.0f ? (t[i] - uvMin[i]) / e : 0.0f);
+      e = fabsf(uvMin[i] + dequantizeUnorm16(uv[i]) * e - t[i]);
+      maxUVError = e > maxUVError ? e : maxUVError;
+    }
+
+    PackedVertex pv;
+    pv.w[0] = word(q[0], q[2] & 0xff);
+    pv.w[1] = word(q[1], q[2] >> 8);
+    pv.w[2] = word(uv[0], (uint32_t) (o[0] + 128));
+    pv.w[3] = word(uv[1], (uint32_t) (o[1] + 128));
+    return pv;
+  }
+};
@@ -1,20 +1,24 @@
-#pragma once
-
-#include <vec.h>
-
-struct Camera {
-  float yawAngle = 0.0f, pitchAngle = 0.0f;
-  float yawSpeed, pitchSpeed;
-  MyGL_Vec3 position = MyGL_Vec3 { .x = 0.0f, .y = 0.0f, .z = 0.0f };
-  float forwardSpeed, strafeSpeed, upSpeed;
-  float fov = 90.0f;
-  float nearPlane = 0.01f;
-  float farPlane = 1000.0f;
-
-  void look(int yaw, int pitch, float dt);
-  void move(int forward, int side, int up, float dt);
-  MyGL_Mat4 worldMatrix() const;
-  MyGL_Mat4 viewMatrix() const;
-  MyGL_Mat4 stereoViewMatrix(float ipd = 0.065, float focalDist = 15.0, bool leftEye = true) const;
-  MyGL_Mat4 projectionMatrix(float aspect = 1.0f) const;
-};
+#pragma once
+
+#include <vec.h>
+
+struct Camera {
+  float yawAngle = 0.0f, pitchAngle = 0.0f;
+  float yawSpeed, pitchSpeed;
+  MyGL_Vec3 position = MyGL_Vec3 { .x = 0.0f, .y = 0.0f, .z = 0.0f };
+  float forwardSpeed, strafeSpeed, upSpeed;
+  float fov = 90.0f;
+  float nearPlane = 0.01f;
+  float farPlane = 1000.0f;
+
+  void look(int yaw, int pitch, float dt);
+  void move(int forward, int side, int up, float dt);
+  MyGL_Mat4 worldMatrix() const;
+  MyGL_Mat4 viewMatrix() const;
+  MyGL_Mat4 stereoViewMatrix(float ipd = 0.065, float focalDist = 15.0, bool leftEye = true) const;
+  MyGL_Mat4 projectionMatrix(float aspect = 1.0f) const;
+  // the eye and world space frustum of stereoViewMatrix() (ipd 0 for viewMatrix()), planes face inwards:
+  // a * x + b * y + c * z + d >= 0 inside
+  MyGL_Vec3 eyePosition(float ipd = 0.065, bool leftEye = true) const;
+  void frustumPlanes(float planes[6][4], float aspect = 1.0f, float ipd = 0.065, bool leftEye = true) const;
+};
@@ -0,0 +1,147 @@
+#include <cstring>
+
+#include "mesh.h"
+
+void print(int type, std::string_view tag, std::string_view format, ...);  // obj.cpp
+
+namespace wavefront {
+
+namespace {
+
+template<typename T>
+size_t bytesOf(const std::vector<T> &v) {
+  return v.capacity() * sizeof(T);
+}
+
+size_t bytesOf(const meshlets::ClusterTable &t) {
+  return bytesOf(t.firstIndex) + bytesOf(t.numIndices) + bytesOf(t.center) + bytesOf(t.radius) +
+         bytesOf(t.boundsMin) + bytesOf(t.boundsMax) + bytesOf(t.coneAxis) + bytesOf(t.coneCutoff);
+}
+
+template<typename T>
+void copyOut(std::vector<T> &dst, const T *src, uint32 count) {
+  dst.assign(src, src + count);
+}
+
+void copyOut(std::vector<Mesh::Vertex> &dst, const OBJ::Vertex *src, uint32 count) {
+  dst.resize(count);
+  for (uint32 i = 0; i < count; i++)
+    dst[i] = Mesh::Vertex { src[i].p, src[i].t };
+}
+
+}
+
+const Mesh::Range* Mesh::findRange(std::string_view material) const {
+  for (const auto &range : ranges) {
+    if (range.material == material)
+      return &range;
+  }
+  return nullptr;
+}
+
+void Mesh::copyIndices(uint32 *dst, uint32 first, uint32 count) const {
+  if (INDEX_UINT32 == indices.format) {
+    memcpy(dst, indices.u32() + first, count * sizeof(uint32));
+    return;
+  }
+  auto src = indices.u16() + first;
+  for (uint32 i = 0; i < count; i++)
+    dst[i] = src[i];
+}
+
+void Mesh::release(bool keepIndices) {
+  std::vector<Vertex>().swap(vertices);
+  if (keepIndices)
+    return;
+  std::vector<uint8>().swap(indices.data);
+  indices.count = 0;
+  clusters = meshlets::ClusterTable();
+}
+
+size_t Mesh::bytes() const {
+  size_t n = bytesOf(vertices) + indices.data.capacity() + bytesOf(ranges) + bytesOf(clusters);
+  for (const auto &r : ranges)
+    n += r.material.capacity();
+  return n;
+}
+
+void Mesh::report(std::string_view name) const {
+  print(0, "Mesh::report", "'%s': %zu vertices (%zu KB), %zu %u-bit indices (%zu KB), %zu ranges, "
+        "%zu clusters (%zu KB), %zu KB in all", name.data(), vertices.size(), bytesOf(vertices) / 1024,
+        indices.size(), indices.format * 8, indices.data.capacity() / 1024, ranges.size(), clusters.size(),
+        bytesOf(clusters) / 1024, bytes() / 1024);
+}
+
+bool MeshBuilder::load(std::string_view objFileName, uint32 numThreads) {
+  const char *tag = "MeshBuilder::load";
+  if (cache.open(objFileName)) {
+    print(0, tag, "'%s' mapped: %u vertices, %u %u-bit indices, %u ranges, %u clusters", cache.file.name.c_str(),
+          cache.numVertices(), cache.numIndices(), cache.indexFormat() * 8, cache.numRanges(),
+          cache.clusters.count);
+    return true;
+  }
+
+  print(0, tag, "no valid cache for '%s', parsing", objFileName.data());
+  if (!obj.load(objFileName, numThreads))
+    return false;
+  // the OBJ is fine even when the cache isn't (e.g. a read-only assets directory), build() then uses it
+  if (!MeshCache::write(objFileName, obj)) {
+    print(1, tag, "no cache for '%s', building the mesh from the parsed OBJ", objFileName.data());
+    return true;
+  }
+  if (!cache.open(objFileName))
+    print(1, tag, "failed to map cache written for '%s', building the mesh from the parsed OBJ",
+          objFileName.data());
+  return true;
+}
+
+void MeshBuilder::build(Mesh &mesh) const {
+  if (!cache.valid()) {
+    buildFromObj(mesh);
+    return;
+  }
+  copyOut(mesh.vertices, cache.vertices, cache.numVertices());
+
+  mesh.indices.clear();
+  mesh.indices.format = cache.indexFormat();
+  mesh.indices.count = cache.numIndices();
+  auto indices = (const uint8*) cache.indices;
+  mesh.indices.data.assign(indices, indices + mesh.indices.bytes());
+
+  mesh.ranges.clear();
+  for (uint32 i = 0; i < cache.numRanges(); i++) {
+    const auto &r = cache.ranges[i];
+    mesh.ranges.push_back(Mesh::Range { std::string(r.material), r.firstIndex, r.count });
+  }
+
+  const auto &c = cache.clusters;
+  copyOut(mesh.clusters.firstIndex, c.firstIndex, c.count);
+  copyOut(mesh.clusters.numIndices, c.numIndices, c.count);
+  copyOut(mesh.clusters.center, c.center, c.count);
+  copyOut(mesh.clusters.radius, c.radius, c.count);
+  copyOut(mesh.clusters.boundsMin, c.boundsMin, c.count);
+  copyOut(mesh.clusters.boundsMax, c.boundsMax, c.count);
+  copyOut(mesh.clusters.coneAxis, c.coneAxis, c.count);
+  copyOut(mesh.clusters.coneCutoff, c.coneCutoff, c.count);
+
+  mesh.boundsMin = cache.header ? cache.header->boundsMin : Vector3();
+  mesh.boundsMax = cache.header ? cache.header->boundsMax : Vector3();
+  mesh.numVertices = cache.numVertices();
+  mesh.numIndices = cache.numIndices();
+}
+
+void MeshBuilder::buildFromObj(Mesh &mesh) const {
+  copyOut(mesh.vertices, obj.vertices.data(), (uint32) obj.vertices.size());
+  mesh.ranges.clear();
+  for (const auto &r : obj.ranges)
+    mesh.ranges.push_back(Mesh::Range { obj.mats[r.material], r.firstIndex, r.count });
+  MeshCache::cluster(obj, mesh.indices, mesh.clusters, mesh.boundsMin, mesh.boundsMax);
+  mesh.numVertices = (uint32) mesh.vertices.size();
+  mesh.numIndices = (uint32) mesh.indices.size();
+}
+
+size_t MeshBuilder::bytes() const {
+  return obj.bytes() + cache.file.size;
+}
+
+}
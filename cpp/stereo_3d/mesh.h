@@ -0,0 +1,61 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "obj.h"
+#include "meshcache.h"
+#include "meshlets.h"
+
+namespace wavefront {
+
+// what a model needs once it is loaded: the vertices and indices to upload, the material ranges and the
+// clusters to cull; none of the parsing scratch (faces, attribute pools, the mapped cache) is kept
+struct Mesh {
+  // what the textured shader reads, 20 bytes; the cache keeps the normals, the VBO doesn't need them
+  struct Vertex {
+    Vector3 p;
+    Vector2 t;
+  };
+
+  struct Range {
+    std::string material;
+    uint32 firstIndex;
+    uint32 count;
+  };
+
+  std::vector<Vertex> vertices;
+  IndexBuffer indices;
+  std::vector<Range> ranges;
+  meshlets::ClusterTable clusters;
+  Vector3 boundsMin;
+  Vector3 boundsMax;
+  uint32 numVertices = 0;  // still valid after release()
+  uint32 numIndices = 0;
+
+  const Range* findRange(std::string_view material) const;
+  void copyIndices(uint32 *dst, uint32 first, uint32 count) const;
+
+  // frees the CPU copy once it is on the GPU; keepIndices holds on to the indices and clusters for
+  // refilling an IBO with the visible clusters
+  void release(bool keepIndices = false);
+  size_t bytes() const;
+  void report(std::string_view name) const;
+};
+
+// build-time side: maps the mesh cache, parsing the OBJ and rewriting the cache when it is missing or stale,
+// and copies the runtime mesh out of it; drop the builder once build() is done
+struct MeshBuilder {
+  OBJ obj;          // only filled when the cache had to be rebuilt
+  MeshCache cache;  // not valid when it couldn't be written or mapped, build() falls back on 'obj'
+
+  bool load(std::string_view objFileName, uint32 numThreads = 1);
+  void build(Mesh &mesh) const;
+  size_t bytes() const;
+
+private:
+  void buildFromObj(Mesh &mesh) const;
+};
+
+}
@@ -0,0 +1,248 @@
+#include <cstdio>
+#include <cstring>
+#include <sys/stat.h>
+
+#include "meshcache.h"
+
+void print(int type, std::string_view tag, std::string_view format, ...);  // obj.cpp
+
+namespace wavefront {
+
+namespace {
+
+struct SourceInfo {
+  uint64 size = 0;
+  int64 time = 0;
+  uint64 hash = 0;
+};
+
+// 8 bytes a step, like the exporter's hashText()
+uint64 hashBytes(const char *p, size_t n) {
+  const uint64 m = 0x9E3779B97F4A7C15ull;
+  uint64 h = 0xcbf29ce484222325ull;
+  for (; n >= 8; p += 8, n -= 8) {
+    uint64 w;
+    memcpy(&w, p, 8);
+    h = (h ^ w) * m;
+    h ^= h >> 29;
+  }
+  uint64 w = 0;
+  memcpy(&w, p, n);
+  h = (h ^ w ^ (uint64) n << 56) * m;
+  return h ^ (h >> 32);
+}
+
+// size and mtime only, cheap enough to reject a stale cache before anything is read
+bool statSource(std::string_view fileName, SourceInfo &info) {
+  std::string file(fileName);
+  struct stat st;
+  if (stat(file.c_str(), &st) != 0)
+    return false;
+  info.size = (uint64) st.st_size;
+  info.time = (int64) st.st_mtime;
+  return true;
+}
+
+bool hashSource(std::string_view fileName, SourceInfo &info) {
+  MappedFile source(fileName);
+  if (!source.valid() || source.size != info.size)
+    return false;
+  info.hash = hashBytes(source.data, source.size);
+  return true;
+}
+
+size_t align8(size_t n) {
+  return (n + 7) & ~size_t(7);
+}
+
+// bytes per cluster in the table, all eight arrays
+constexpr size_t clusterSize = 2 * sizeof(uint32) + 4 * sizeof(Vector3) + 2 * sizeof(float);
+
+}
+
+std::string MeshCache::cacheFileName(std::string_view objFileName) {
+  std::string name(objFileName);
+  auto dot = name.find_last_of('.');
+  auto slash = name.find_last_of("/\\");
+  if (dot != std::string::npos && (slash == std::string::npos || dot > slash))
+    name.resize(dot);
+  return name + ".meshbin";
+}
+
+void MeshCache::close() {
+  file.close();
+  header = nullptr;
+  vertices = nullptr;
+  indices = nullptr;
+  ranges = nullptr;
+  clusters = meshlets::ClusterView();
+}
+
+bool MeshCache::open(std::string_view objFileName) {
+  close();
+  SourceInfo info;
+  if (!statSource(objFileName, info))
+    return false;
+  if (!file.open(cacheFileName(objFileName)))
+    return false;
+
+  auto h = (const Header*) file.data;
+  bool ok = file.size >= sizeof(Header);
+  ok = ok && 0 == memcmp(h->magic, "MESHBIN", 8) && version == h->version;
+  ok = ok && sizeof(OBJ::Vertex) == h->vertexSize && IndexBuffer::formatFor(h->numVertices) == h->indexSize;
+  ok = ok && info.size == h->sourceSize && info.time == h->sourceTime;
+  ok = ok && h->vertexOffset + (uint64) h->numVertices * sizeof(OBJ::Vertex) <= file.size;
+  ok = ok && h->indexOffset + (uint64) h->numIndices * h->indexSize <= file.size;
+  ok = ok && h->rangeOffset + (uint64) h->numRanges * sizeof(Range) <= file.size;
+  ok = ok && h->clusterOffset + (uint64) h->numClusters * clusterSize <= file.size;
+  // the source is read only once everything else matched
+  ok = ok && hashSource(objFileName, info) && info.hash == h->sourceHash;
+  if (!ok) {
+    close();
+    return false;
+  }
+
+  header = h;
+  vertices = (const OBJ::Vertex*) (file.data + h->vertexOffset);
+  indices = file.data + h->indexOffset;
+  ranges = (const Range*) (file.data + h->rangeOffset);
+
+  const char *c = file.data + h->clusterOffset;
+  uint32 n = h->numClusters;
+  clusters.count = n;
+  clusters.firstIndex = (const uint32*) c;
+  clusters.numIndices = clusters.firstIndex + n;
+  clusters.center = (const Vector3*) (clusters.numIndices + n);
+  clusters.radius = (const float*) (clusters.center + n);
+  clusters.boundsMin = (const Vector3*) (clusters.radius + n);
+  clusters.boundsMax = clusters.boundsMin + n;
+  clusters.coneAxis = clusters.boundsMax + n;
+  clusters.coneCutoff = (const float*) (clusters.coneAxis + n);
+  return true;
+}
+
+void MeshCache::copyIndices(uint32 *dst) const {
+  copyIndices(dst, 0, numIndices());
+}
+
+void MeshCache::copyIndices(uint32 *dst, uint32 first, uint32 count) const {
+  if (INDEX_UINT32 == indexFormat()) {
+    memcpy(dst, (const uint32*) indices + first, count * sizeof(uint32));
+    return;
+  }
+  auto src = (const uint16*) indices + first;
+  for (uint32 i = 0; i < count; i++)
+    dst[i] = src[i];
+}
+
+void MeshCache::cluster(const OBJ &obj, IndexBuffer &clustered, meshlets::ClusterTable &table,
+                        Vector3 &boundsMin, Vector3 &boundsMax) {
+  // the loader already sorted the faces by material, every range is one material
+  std::vector<uint32> indices(obj.indices.size());
+  obj.indices.copyTo(indices.data());
+  std::vector<Vector3> positions;
+  positions.reserve(obj.vertices.size());
+  for (const auto &v : obj.vertices)
+    positions.push_back(v.p);
+  table.clear();
+  for (const auto &r : obj.ranges)
+    meshlets::buildClusters(indices.data(), r.firstIndex, r.count, positions, table);
+  clustered.clear();
+  clustered.format = obj.indices.format;
+  clustered.reserve(indices.size());
+  for (uint32 v : indices)
+    clustered.push_back(v);
+
+  boundsMin = boundsMax = positions.size() ? positions[0] : Vector3();
+  for (const auto &p : positions) {
+    for (int i = 0; i < 3; i++) {
+      boundsMin.xyz[i] = p.xyz[i] < boundsMin.xyz[i] ? p.xyz[i] : boundsMin.xyz[i];
+      boundsMax.xyz[i] = p.xyz[i] > boundsMax.xyz[i] ? p.xyz[i] : boundsMax.xyz[i];
+    }
+  }
+}
+
+bool MeshCache::write(std::string_view objFileName, const OBJ &obj) {
+  const char *tag = "MeshCache::write";
+  SourceInfo info;
+  if (!statSource(objFileName, info) || !hashSource(objFileName, info)) {
+    print(2, tag, "'%s' not found", objFileName.data());
+    return false;
+  }
+
+  // the loader already sorted the faces by material, every range is one material
+  std::vector<Range> runs;
+  for (const auto &range : obj.ranges) {
+    Range r;
+    memset(&r, 0, sizeof(r));
+    strncpy(r.material, obj.mats[range.material].c_str(), sizeof(r.material) - 1);
+    r.firstIndex = range.firstIndex;
+    r.count = range.count;
+    runs.push_back(r);
+  }
+
+  IndexBuffer clustered;
+  meshlets::ClusterTable table;
+  Vector3 boundsMin, boundsMax;
+  cluster(obj, clustered, table, boundsMin, boundsMax);
+
+  Header h {};
+  memcpy(h.magic, "MESHBIN", 8);
+  h.version = version;
+  h.vertexSize = sizeof(OBJ::Vertex);
+  h.indexSize = obj.indices.format;
+  h.sourceSize = info.size;
+  h.sourceTime = info.time;
+  h.sourceHash = info.hash;
+  h.numVertices = (uint32) obj.vertices.size();
+  h.numIndices = (uint32) obj.indices.size();
+  h.numRanges = (uint32) runs.size();
+  h.vertexOffset = align8(sizeof(Header));
+  h.indexOffset = align8(h.vertexOffset + obj.vertices.size() * sizeof(OBJ::Vertex));
+  h.rangeOffset = align8(h.indexOffset + clustered.bytes());
+  h.clusterOffset = align8(h.rangeOffset + runs.size() * sizeof(Range));
+  h.numClusters = (uint32) table.size();
+  h.boundsMin = boundsMin;
+  h.boundsMax = boundsMax;
+
+  std::string cacheFile = cacheFileName(objFileName);
+  FILE *fp = fopen(cacheFile.c_str(), "wb");
+  if (!fp) {
+    print(2, tag, "failed to open file '%s' for writing", cacheFile.c_str());
+    return false;
+  }
+  auto pad = [&](uint64 offset) {
+    static const char zeros[8] = { 0 };
+    long at = ftell(fp);
+    if ((uint64) at < offset)
+      fwrite(zeros, 1, offset - at, fp);
+  };
+  fwrite(&h, sizeof(h), 1, fp);
+  pad(h.vertexOffset);
+  fwrite(obj.vertices.data(), sizeof(OBJ::Vertex), obj.vertices.size(), fp);
+  pad(h.indexOffset);
+  fwrite(clustered.data.data(), 1, clustered.bytes(), fp);
+  pad(h.rangeOffset);
+  fwrite(runs.data(), sizeof(Range), runs.size(), fp);
+  pad(h.clusterOffset);
+  fwrite(table.firstIndex.data(), sizeof(uint32), table.size(), fp);
+  fwrite(table.numIndices.data(), sizeof(uint32), table.size(), fp);
+  fwrite(table.center.data(), sizeof(Vector3), table.size(), fp);
+  fwrite(table.radius.data(), sizeof(float), table.size(), fp);
+  fwrite(table.boundsMin.data(), sizeof(Vector3), table.size(), fp);
+  fwrite(table.boundsMax.data(), sizeof(Vector3), table.size(), fp);
+  fwrite(table.coneAxis.data(), sizeof(Vector3), table.size(), fp);
+  fwrite(table.coneCutoff.data(), sizeof(float), table.size(), fp);
+  bool ok = 0 == ferror(fp);
+  fclose(fp);
+  if (!ok) {
+    remove(cacheFile.c_str());
+    print(2, tag, "failed to write '%s'", cacheFile.c_str());
+    return false;
+  }
+  print(0, tag, "'%s' written: %u vertices, %u %u-bit indices, %u ranges, %u clusters", cacheFile.c_str(),
+        h.numVertices, h.numIndices, h.indexSize * 8, h.numRanges, h.numClusters);
+  return true;
+}
+
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include "obj.h"
+#include "mappedfile.h"
+#include "meshlets.h"
+
+namespace wavefront {
+
+// binary cache of a loaded OBJ, written next to the source ('crate.obj' -> 'crate.meshbin')
+// and memory mapped on load; valid only while the source's size, mtime and content hash match.
+// the triangles of each range are stored in clusters (see meshlets.h), whose table follows the ranges
+struct MeshCache {
+  static constexpr uint32 version = 5;
+
+  struct Header {
+    char magic[8];  // "MESHBIN"
+    uint32 version;
+    uint32 vertexSize;
+    uint64 sourceSize;
+    int64 sourceTime;
+    uint64 sourceHash;
+    uint32 numVertices;
+    uint32 numIndices;
+    uint32 numRanges;
+    uint32 indexSize;  // IndexFormat
+    uint64 vertexOffset;
+    uint64 indexOffset;
+    uint64 rangeOffset;
+    uint64 clusterOffset;  // firstIndex, numIndices, center, radius, boundsMin, boundsMax, coneAxis, coneCutoff
+    Vector3 boundsMin;
+    Vector3 boundsMax;
+    uint32 numClusters;
+  };
+
+  // the triangles of one material, OBJ::Range with the material name in place of its id
+  struct Range {
+    char material[56];
+    uint32 firstIndex;
+    uint32 count;
+  };
+
+  MappedFile file;
+  const Header *header = nullptr;
+  const OBJ::Vertex *vertices = nullptr;
+  const void *indices = nullptr;  // uint16 or uint32, see indexFormat()
+  const Range *ranges = nullptr;
+  meshlets::ClusterView clusters;
+
+  bool valid() const {
+    return header != nullptr;
+  }
+  uint32 numVertices() const {
+    return header ? header->numVertices : 0;
+  }
+  uint32 numIndices() const {
+    return header ? header->numIndices : 0;
+  }
+  uint32 numRanges() const {
+    return header ? header->numRanges : 0;
+  }
+  IndexFormat indexFormat() const {
+    return header ? (IndexFormat) header->indexSize : INDEX_UINT16;
+  }
+
+  // widens the indices into a 32-bit destination (e.g. an IBO stream)
+  void copyIndices(uint32 *dst) const;
+  void copyIndices(uint32 *dst, uint32 first, uint32 count) const;
+
+  // maps the cache for 'objFileName', fails if it's missing or stale; MeshBuilder::load() rebuilds it
+  bool open(std::string_view objFileName);
+  void close();
+
+  // what write() stores besides the vertices and ranges: every range's triangles reordered into clusters,
+  // the cluster table and the bounds; MeshBuilder uses it directly when the cache can't be written
+  static void cluster(const OBJ &obj, IndexBuffer &clustered, meshlets::ClusterTable &table, Vector3 &boundsMin,
+                      Vector3 &boundsMax);
+  static bool write(std::string_view objFileName, const OBJ &obj);
+  static std::string cacheFileName(std::string_view objFileName);
+};
+
+}
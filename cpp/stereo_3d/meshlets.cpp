@@ -0,0 +1,243 @@
+#include "meshlets.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace meshlets {
+
+void ClusterTable::clear() {
+  firstIndex.clear();
+  numIndices.clear();
+  center.clear();
+  radius.clear();
+  boundsMin.clear();
+  boundsMax.clear();
+  coneAxis.clear();
+  coneCutoff.clear();
+}
+
+ClusterView::ClusterView(const ClusterTable &table) {
+  count = (uint32) table.size();
+  firstIndex = table.firstIndex.data();
+  numIndices = table.numIndices.data();
+  center = table.center.data();
+  radius = table.radius.data();
+  boundsMin = table.boundsMin.data();
+  boundsMax = table.boundsMax.data();
+  coneAxis = table.coneAxis.data();
+  coneCutoff = table.coneCutoff.data();
+}
+
+namespace {
+
+void addBounds(const uint32 *indices, uint32 count, const std::vector<Vector3> &positions, ClusterTable &table) {
+  Vector3 lo = positions[indices[0]], hi = lo;
+  for (uint32 i = 1; i < count; i++) {
+    const Vector3 &p = positions[indices[i]];
+    for (int k = 0; k < 3; k++) {
+      lo.xyz[k] = std::min(lo.xyz[k], p.xyz[k]);
+      hi.xyz[k] = std::max(hi.xyz[k], p.xyz[k]);
+    }
+  }
+  Vector3 c = (lo + hi) * 0.5f;
+  float r = 0.0f;
+  for (uint32 i = 0; i < count; i++)
+    r = std::max(r, (positions[indices[i]] - c).length());
+
+  // the cone around the average normal that holds every triangle normal; no culling when it's close to
+  // a hemisphere or wider
+  Vector3 axis;
+  std::vector<Vector3> normals;
+  normals.reserve(count / 3);
+  for (uint32 i = 0; i < count; i += 3) {
+    const Vector3 &a = positions[indices[i]];
+    Vector3 n = (positions[indices[i + 1]] - a).cross(positions[indices[i + 2]] - a);
+    float l = n.length();
+    if (l <= 0.0f)
+      continue;
+    n *= 1.0f / l;
+    normals.push_back(n);
+    axis += n;
+  }
+  float cutoff = 1.0f;
+  float l = axis.length();
+  if (l > 0.0f) {
+    axis *= 1.0f / l;
+    float minDot = 1.0f;
+    for (const auto &n : normals)
+      minDot = std::min(minDot, axis.dot(n));
+    if (minDot > 0.1f)
+      cutoff = sqrtf(1.0f - minDot * minDot);
+  }
+
+  table.center.push_back(c);
+  table.radius.push_back(r);
+  table.boundsMin.push_back(lo);
+  table.boundsMax.push_back(hi);
+  table.coneAxis.push_back(axis);
+  table.coneCutoff.push_back(cutoff);
+}
+
+}
+
+void buildClusters(uint32 *indices, uint32 firstIndex, uint32 count, const std::vector<Vector3> &positions,
+                   ClusterTable &table) {
+  uint32 numTris = count / 3;
+  if (!numTris)
+    return;
+  const uint32 *tris = indices + firstIndex;
+
+  // local vertex ids, counted against maxVertices
+  std::vector<uint32> local(tris, tris + numTris * 3);
+  std::sort(local.begin(), local.end());
+  local.erase(std::unique(local.begin(), local.end()), local.end());
+  std::vector<uint32> corners(numTris * 3);
+  for (uint32 i = 0; i < numTris * 3; i++)
+    corners[i] = (uint32) (std::lower_bound(local.begin(), local.end(), tris[i]) - local.begin());
+
+  // triangles are neighbours when they share a position, vertices split by normals or UVs still connect
+  std::vector<uint32> byPosition(local.size());
+  for (uint32 i = 0; i < local.size(); i++)
+    byPosition[i] = i;
+  auto positionLess = [&](uint32 a, uint32 b) {
+    const Vector3 &p = positions[local[a]], &q = positions[local[b]];
+    return p.x != q.x ? p.x < q.x : p.y != q.y ? p.y < q.y : p.z < q.z;
+  };
+  std::sort(byPosition.begin(), byPosition.end(), positionLess);
+  std::vector<uint32> groupOf(local.size());
+  uint32 numGroups = 0;
+  for (uint32 i = 0; i < byPosition.size(); i++) {
+    if (i && positionLess(byPosition[i - 1], byPosition[i]))
+      numGroups++;
+    groupOf[byPosition[i]] = numGroups;
+  }
+  numGroups++;
+
+  // position -> triangles, compressed rows
+  std::vector<uint32> offsets(numGroups + 1, 0);
+  for (uint32 v : corners)
+    offsets[groupOf[v] + 1]++;
+  for (size_t g = 1; g <= numGroups; g++)
+    offsets[g] += offsets[g - 1];
+  std::vector<uint32> adjacent(corners.size());
+  {
+    std::vector<uint32> next(offsets.begin(), offsets.end() - 1);
+    for (uint32 i = 0; i < corners.size(); i++)
+      adjacent[next[groupOf[corners[i]]]++] = i / 3;
+  }
+
+  std::vector<Vector3> centroids(numTris);
+  for (uint32 t = 0; t < numTris; t++)
+    centroids[t] = (positions[tris[t * 3]] + positions[tris[t * 3 + 1]] + positions[tris[t * 3 + 2]]) * (1.0f / 3.0f);
+
+  std::vector<uint8> emitted(numTris, 0);
+  std::vector<uint32> clusterOf(local.size(), ~0u);  // the last cluster each vertex joined
+  std::vector<uint32> groupClusterOf(numGroups, ~0u);  // the last cluster each position joined
+  std::vector<uint32> out;
+  out.reserve(numTris * 3);
+  std::vector<uint32> clusterVerts, frontier;
+  uint32 cursor = 0;
+  uint32 cluster = 0;
+
+  while (out.size() < numTris * 3) {
+    while (emitted[cursor])
+      cursor++;
+
+    uint32 clusterStart = (uint32) out.size();
+    clusterVerts.clear();
+    frontier.clear();
+    Vector3 sum;
+    uint32 numClusterTris = 0;
+
+    auto newVertices = [&](uint32 t) {
+      uint32 n = 0;
+      for (int k = 0; k < 3; k++)
+        n += clusterOf[corners[t * 3 + k]] != cluster;
+      return n;
+    };
+    auto add = [&](uint32 t) {
+      emitted[t] = 1;
+      for (int k = 0; k < 3; k++) {
+        uint32 v = corners[t * 3 + k];
+        out.push_back(tris[t * 3 + k]);
+        if (clusterOf[v] != cluster) {
+          clusterOf[v] = cluster;
+          clusterVerts.push_back(v);
+        }
+        uint32 g = groupOf[v];
+        if (groupClusterOf[g] != cluster) {
+          groupClusterOf[g] = cluster;
+          frontier.insert(frontier.end(), adjacent.begin() + offsets[g], adjacent.begin() + offsets[g + 1]);
+        }
+      }
+      sum += centroids[t];
+      numClusterTris++;
+    };
+
+    add(cursor);
+    while (numClusterTris < maxTriangles) {
+      Vector3 centre = sum * (1.0f / (float) numClusterTris);
+      int64 best = -1;
+      uint32 bestNew = 4;
+      float bestDistance = 0.0f;
+      for (uint32 t : frontier) {
+        if (emitted[t])
+          continue;
+        uint32 n = newVertices(t);
+        if (clusterVerts.size() + n > maxVertices)
+          continue;
+        float d = (centroids[t] - centre).length();
+        if (n < bestNew || (n == bestNew && d < bestDistance)) {
+          best = t;
+          bestNew = n;
+          bestDistance = d;
+        }
+      }
+      if (best < 0)
+        break;
+      add((uint32) best);
+    }
+
+    table.firstIndex.push_back(firstIndex + clusterStart);
+    table.numIndices.push_back((uint32) out.size() - clusterStart);
+    addBounds(out.data() + clusterStart, (uint32) out.size() - clusterStart, positions, table);
+    cluster++;
+  }
+
+  std::copy(out.begin(), out.end(), indices + firstIndex);
+}
+
+bool outside(const Frustum &frustum, const Vector3 &center, float radius) {
+  for (int i = 0; i < 6; i++) {
+    const float *p = frustum.planes[i];
+    if (p[0] * center.x + p[1] * center.y + p[2] * center.z + p[3] < -radius)
+      return true;
+  }
+  return false;
+}
+
+bool backfacing(const ClusterView &clusters, uint32 i, const Vector3 &eye) {
+  // the sphere-based cone test: no point of the sphere can see the front of any triangle in the cone
+  Vector3 d = clusters.center[i] - eye;
+  return d.dot(clusters.coneAxis[i]) > clusters.coneCutoff[i] * d.length() + clusters.radius[i];
+}
+
+void cull(const ClusterView &clusters, const Frustum &frustum, const Vector3 &eye, std::vector<uint32> &visible) {
+  for (uint32 i = 0; i < clusters.count; i++)
+    if (!outside(frustum, clusters.center[i], clusters.radius[i]) && !backfacing(clusters, i, eye))
+      visible.push_back(i);
+}
+
+void cull(const ClusterView &clusters, const Frustum *frusta, const Vector3 *eyes, uint32 numViews,
+          std::vector<uint32> &visible) {
+  for (uint32 i = 0; i < clusters.count; i++) {
+    for (uint32 v = 0; v < numViews; v++) {
+      if (!outside(frusta[v], clusters.center[i], clusters.radius[i]) && !backfacing(clusters, i, eyes[v])) {
+        visible.push_back(i);
+        break;
+      }
+    }
+  }
+}
+
+}
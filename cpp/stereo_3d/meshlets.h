@@ -0,0 +1,73 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+#include "defs.h"
+#include "myvector.h"
+
+// clusters of at most maxVertices vertices / maxTriangles triangles, each a contiguous run of a reordered
+// index buffer, with the bounds needed to reject whole clusters on the CPU before anything is drawn
+namespace meshlets {
+
+constexpr uint32 maxVertices = 64;
+constexpr uint32 maxTriangles = 124;
+
+// structure of arrays, cluster i is indices[firstIndex[i], firstIndex[i] + numIndices[i])
+struct ClusterTable {
+  std::vector<uint32> firstIndex;
+  std::vector<uint32> numIndices;
+  std::vector<Vector3> center;      // bounding sphere
+  std::vector<float> radius;
+  std::vector<Vector3> boundsMin;   // AABB
+  std::vector<Vector3> boundsMax;
+  std::vector<Vector3> coneAxis;    // average facing of the triangles
+  std::vector<float> coneCutoff;    // sine of the cone's half angle, 1 when the cluster can't be backface culled
+
+  size_t size() const {
+    return firstIndex.size();
+  }
+  void clear();
+};
+
+// read-only view of a table (e.g. one mapped from a mesh cache), laid out the same way
+struct ClusterView {
+  uint32 count = 0;
+  const uint32 *firstIndex = nullptr;
+  const uint32 *numIndices = nullptr;
+  const Vector3 *center = nullptr;
+  const float *radius = nullptr;
+  const Vector3 *boundsMin = nullptr;
+  const Vector3 *boundsMax = nullptr;
+  const Vector3 *coneAxis = nullptr;
+  const float *coneCutoff = nullptr;
+
+  ClusterView() = default;
+  ClusterView(const ClusterTable &table);
+};
+
+// reorders the triangles of indices[firstIndex, firstIndex + count) into clusters and appends them to
+// 'table'; call once per material range so no cluster spans two. triangles are gathered greedily from a
+// seed, the ones adding the fewest new vertices and then the ones closest to the cluster first
+void buildClusters(uint32 *indices, uint32 firstIndex, uint32 count, const std::vector<Vector3> &positions,
+                   ClusterTable &table);
+
+// inward facing planes (a, b, c, d): a point p is inside when a * p.x + b * p.y + c * p.z + d >= 0 for all six
+struct Frustum {
+  float planes[6][4];
+};
+
+// true when the sphere is entirely outside one of the planes
+bool outside(const Frustum &frustum, const Vector3 &center, float radius);
+
+// true when every triangle of the cluster faces away from 'eye'
+bool backfacing(const ClusterView &clusters, uint32 i, const Vector3 &eye);
+
+// the clusters inside the frustum and facing 'eye' (both in the clusters' space), appended to 'visible'
+void cull(const ClusterView &clusters, const Frustum &frustum, const Vector3 &eye, std::vector<uint32> &visible);
+
+// the clusters at least one of the views sees, e.g. both eyes of a stereo pair from a single cull
+void cull(const ClusterView &clusters, const Frustum *frusta, const Vector3 *eyes, uint32 numViews,
+          std::vector<uint32> &visible);
+
+}
@@ -1,328 +1,521 @@
-#include <sstream>
-#include <cstring>
-#include <set>
-#include <cstdarg>
-#include <sstream>
-#include <functional>
-
-#include "obj.h"
-
-void print(int type, std::string_view tag, std::string_view format, ...) {
-  std::stringstream ss;
-  char buffer[1024];
-  if (0 == type)
-    ss << "[INFO]..: " << tag << " - ";
-  if (1 == type)
-    ss << "[WARN]..: " << tag << " - ";
-  if (2 == type)
-    ss << "[ERROR].: " << tag << " - ";
-
-  va_list args;
-  va_start(args, format);
-  vsnprintf(buffer, sizeof(buffer), format.data(), args);
-  va_end(args);
-  ss << buffer;
-  printf("%s\n", ss.str().c_str());
-}
-
-namespace wavefront {
-
-bool OBJ::Vertex::operator <(const Vertex &rhs) const {
-  if (p < rhs.p)
-    return true;
-  if (p > rhs.p)
-    return false;
-
-  if (n < rhs.n)
-    return true;
-  if (n > rhs.n)
-    return false;
-
-  if (t < rhs.t)
-    return true;
-  if (t > rhs.t)
-    return false;
-
-  return false;
-}
-
-bool OBJ::Vertex::operator >(const Vertex &rhs) const {
-  return rhs < *this;
-}
-
-bool OBJ::Vertex::operator ==(const Vertex &rhs) const {
-  return p == rhs.p && t == rhs.t && t == rhs.t;
-}
-
-bool OBJ::load(std::string_view fileName) {
-  const char *tag = "Obj::Load";
-
-  //0,1,2, info/warn/error
-  auto print = [&](int type, std::string_view format, ...) {
-    std::stringstream ss;
-    char buffer[1024];
-    if (0 == type)
-      ss << "[INFO]..: " << tag << " - ";
-    if (1 == type)
-      ss << "[WARN]..: " << tag << " - ";
-    if (2 == type)
-      ss << "[ERROR].: " << tag << " - ";
-
-    va_list args;
-    va_start(args, format);
-    vsnprintf(buffer, sizeof(buffer), format.data(), args);
-    va_end(args);
-    ss << buffer;
-    printf("%s\n", ss.str().c_str());
-  };
-
-  FILE *fp = fopen(fileName.data(), "r");
-
-  if (!fp) {
-    print(2, "file '%s' not found", fileName.data());
-    return false;
-  }
-  print(0, "loading OBJ from file '%s'", fileName.data());
-
-  pts.clear();
-  uvs.clear();
-  mats.clear();
-  faces.clear();
-  materialFaces.clear();
-
-  char line[256];
-
-  std::string matCurr;
-  int matIndex;
-
-  mats.push_back("__default__");
-  matCurr = mats.back();
-  matIndex = 0;
-
-  while (fgets(line, sizeof(line), fp)) {
-    if ('v' == line[0] && ' ' == line[1]) {
-      Vector3 v;
-      sscanf(&line[2], "%f %f %f", &v.x, &v.y, &v.z);
-      pts.push_back(v);
-    }
-
-    if ('v' == line[0] && 'n' == line[1]) {
-      Vector3 v;
-      sscanf(&line[3], "%f %f %f", &v.x, &v.y, &v.z);
-      nos.push_back(v);
-    }
-
-    if ('v' == line[0] && 't' == line[1]) {
-      Vector2 v;
-      sscanf(&line[3], "%f %f", &v.x, &v.y);
-      uvs.push_back(v);
-    }
-
-    if (0 == memcmp("usemtl", line, 6)) {
-      mats.push_back(std::string(strtok(&line[7], " \n")));
-      matCurr = mats.back();
-      matIndex = (int) mats.size() - 1;
-    }
-    if ('f' == line[0] && ' ' == line[1]) {
-      Face face;
-      face.m = matIndex;
-      char *tok = strtok(&line[2], " \n");
-      int slashes = 0;
-      for (int c = 0; tok[c] != '\0'; c++)
-        if ('/' == tok[c])
-          slashes++;
-      if (1 == slashes) {
-        sscanf(tok, "%d/%d", &face.v.p, &face.v.uv);
-        sscanf(strtok(nullptr, " \n"), "%d/%d", &face.v.p, &face.v.uv);
-        sscanf(strtok(nullptr, " \n"), "%d/%d", &face.v.p, &face.v.uv);
-      } else {
-        if (strstr(tok, "//")) {
-          sscanf(tok, "%d//%d", &face.v.p, &face.v.n);
-          sscanf(strtok(nullptr, " \n"), "%d//%d", &face.v2.p, &face.v2.n);
-          sscanf(strtok(nullptr, " \n"), "%d//%d", &face.v3.p, &face.v3.n);
-        } else {
-          sscanf(tok, "%d/%d/%d", &face.v.p, &face.v.uv, &face.v.n);
-          sscanf(strtok(nullptr, " \n"), "%d/%d/%d", &face.v2.p, &face.v2.uv, &face.v2.n);
-          sscanf(strtok(nullptr, " \n"), "%d/%d/%d", &face.v3.p, &face.v3.uv, &face.v3.n);
-        }
-      }
-
-      faces.push_back(face);
-      materialFaces[matCurr].push_back(faces.size() - 1);
-    }
-  }
-  fclose(fp);
-
-  std::set<Vertex> sortedVerts;
-  size_t n = 0;
-  for (auto &f : faces) {
-    //materialFaces[ mats[f.m] ].push_back(n);
-    for (int i = 0; i < 3; i++) {
-      f.verts[i].p = pts[f.vs[i].p - 1];
-      f.verts[i].n = nos[f.vs[i].n - 1];
-      f.verts[i].t = uvs[f.vs[i].uv - 1];
-      sortedVerts.insert(f.verts[i]);
-    }
-    n++;
-  }
-
-  // these are now sorted
-  for (auto vert : sortedVerts)
-    vertices.push_back(vert);
-
-  auto find = [&](const Vertex &v) {
-    int l = 0;
-    int r = (int) vertices.size() - 1;
-    while (l <= r) {
-      int m = (l + r) / 2;
-      if (v > vertices[m])
-        l = m + 1;
-      else if (v < vertices[m])
-        r = m - 1;
-      else
-        return m;
-    }
-    return -1;
-  };
-
-  for (auto &face : faces) {
-    face.ids[0] = find(face.verts[0]);
-    face.ids[1] = find(face.verts[1]);
-    face.ids[2] = find(face.verts[2]);
-    indices.push_back(face.ids[0]);
-    indices.push_back(face.ids[1]);
-    indices.push_back(face.ids[2]);
-  }
-
-  return true;
-}
-
-bool OBJ::loadMaterials(std::string_view fileName) {
-  const char *tag = "Obj::laodMaterials";
-
-  //0,1,2, info/warn/error
-  auto print = [&](int type, std::string_view format, ...) {
-    std::stringstream ss;
-    char buffer[1024];
-    if (0 == type)
-      ss << "[INFO]..: " << tag << " - ";
-    if (1 == type)
-      ss << "[WARN]..: " << tag << " - ";
-    if (2 == type)
-      ss << "[ERROR].: " << tag << " - ";
-
-    va_list args;
-    va_start(args, format);
-    vsnprintf(buffer, sizeof(buffer), format.data(), args);
-    va_end(args);
-    ss << buffer;
-    printf("%s\n", ss.str().c_str());
-  };
-
-  FILE *fp = fopen(fileName.data(), "r");
-
-  if (!fp) {
-    print(2, "file '%s' not found", fileName.data());
-    return false;
-  }
-  print(0, "loading OBJ materials from file '%s'", fileName.data());
-
-  char line[256];
-  int lineNo = -1;
-  while (fgets(line, sizeof(line), fp)) {
-    lineNo++;
-    if ('#' == line[0])
-      continue;
-    auto *p = strchr(line, '\n');
-    if (p)
-      *p = '\0';
-
-    print(0, "%s", line);
-
-    char *toks[3];
-    toks[0] = strtok(line, " \n");
-    toks[1] = strtok(nullptr, " \n");
-    toks[2] = strtok(nullptr, " \n");
-    if (toks[0] == nullptr || toks[1] == nullptr || toks[2] == nullptr) {
-      print(1, "invalid material at line %d", lineNo);
-    }
-    auto &material = materials[std::string(toks[0])];
-    material.name = std::string(toks[0]);
-    material.albedo.fromHex(toks[1]);
-    material.emission.fromHex(toks[2]);
-  }
-
-  return true;
-}
-
-void exportObj(std::string_view fileName, const OBJ &obj) {
-  FILE *fp = fopen(fileName.data(), "w");
-  if (!fp) {
-    print(2, __FUNCTION__, "failed to open file '%s' for writing", fileName.data());
-    return;
-  }
-  fprintf(fp, "# %s - %zu vertices / %zu faces\n", fileName.data(), obj.vertices.size(), obj.faces.size());
-  fprintf(fp, "# positions:\n");
-  for (auto v : obj.vertices)
-    fprintf(fp, "v %f %f %f\n", v.p.x, v.p.y, v.p.z);
-
-  fprintf(fp, "# normals:\n");
-  for (auto v : obj.vertices)
-    fprintf(fp, "vn %f %f %f\n", v.n.x, v.n.y, v.n.z);
-
-  fprintf(fp, "# uvs:\n");
-  for (auto v : obj.vertices)
-    fprintf(fp, "vt %f %f\n", v.t.x, v.t.y);
-
-  fprintf(fp, "# faces:\n");
-  for (auto f : obj.faces) {
-    fprintf(fp, "f");
-    for (int i = 0; i < 3; i++) {
-      fprintf(fp, " %d/%d/%d", f.ids[i] + 1, f.ids[i] + 1, f.ids[i] + 1);
-    }
-    fprintf(fp, "\n");
-  }
-
-  print(0, __FUNCTION__, "exporting OBJ to file '%s'...", fileName.data());
-  print(0, __FUNCTION__, "%s", "done!");
-  fclose(fp);
-}
-
-void exportObj(std::string_view fileName, OBJ &obj, std::string material) {
-  FILE *fp = fopen(fileName.data(), "w");
-  if (!fp) {
-    print(2, __FUNCTION__, "failed to open file '%s' for writing", fileName.data());
-    return;
-  }
-  fprintf(fp, "# %s - %zu vertices / %zu faces\n", fileName.data(), obj.vertices.size(), obj.faces.size());
-  fprintf(fp, "# positions:\n");
-  for (auto v : obj.vertices)
-    fprintf(fp, "v %f %f %f\n", v.p.x, v.p.y, v.p.z);
-
-  fprintf(fp, "# normals:\n");
-  for (auto v : obj.vertices)
-    fprintf(fp, "vn %f %f %f\n", v.n.x, v.n.y, v.n.z);
-
-  fprintf(fp, "# uvs:\n");
-  for (auto v : obj.vertices)
-    fprintf(fp, "vt %f %f\n", v.t.x, v.t.y);
-
-  fprintf(fp, "# faces:\n");
-
-  const auto &faces = obj.materialFaces[material];
-
-  for (auto i : faces) {
-    auto &f = obj.faces[i];
-    fprintf(fp, "f");
-    for (int i = 0; i < 3; i++) {
-      fprintf(fp, " %d/%d/%d", f.ids[i] + 1, f.ids[i] + 1, f.ids[i] + 1);
-    }
-    fprintf(fp, "\n");
-  }
-
-  print(0, __FUNCTION__, "exporting OBJ to file '%s'...", fileName.data());
-  print(0, __FUNCTION__, "%s", "done!");
-  fclose(fp);
-}
-
-}
+#include <sstream>
+#include <cstring>
+#include <cstdarg>
+#include <sstream>
+#include <functional>
+#include <cstdint>
+
+#include "obj.h"
+#include "mappedfile.h"
+#include "textscan.h"
+#include "linechunks.h"
+#include "vertexindexer.h"
+#include "textwriter.h"
+
+void print(int type, std::string_view tag, std::string_view format, ...) {
+  std::stringstream ss;
+  char buffer[1024];
+  if (0 == type)
+    ss << "[INFO]..: " << tag << " - ";
+  if (1 == type)
+    ss << "[WARN]..: " << tag << " - ";
+  if (2 == type)
+    ss << "[ERROR].: " << tag << " - ";
+
+  va_list args;
+  va_start(args, format);
+  vsnprintf(buffer, sizeof(buffer), format.data(), args);
+  va_end(args);
+  ss << buffer;
+  printf("%s\n", ss.str().c_str());
+}
+
+namespace wavefront {
+
+namespace {
+
+// lines parsed by one thread; material indices are local to the chunk
+struct OBJChunk {
+  std::vector<Vector3> pts;
+  std::vector<Vector3> nos;
+  std::vector<Vector2> uvs;
+  std::vector<std::string> mats;
+  std::vector<OBJ::Face> faces;
+
+  static const char* scanFloats(const char *p, const char *end, float *fs, int n) {
+    using namespace textscan;
+    for (int i = 0; i < n; i++) {
+      p = skipBlanks(p, end);
+      const char *q = scanFloat(p, end, fs[i]);
+      if (q == p)
+        break;
+      p = q;
+    }
+    return p;
+  }
+
+  // 'p', 'p/uv', 'p//n' or 'p/uv/n'
+  static const char* scanCorner(const char *p, const char *end, OBJ::Face::Vertex &v) {
+    using namespace textscan;
+    int *fields[3] = { &v.p, &v.uv, &v.n };
+    p = skipBlanks(p, end);
+    for (int i = 0; i < 3; i++) {
+      if (i > 0) {
+        if (p >= end || '/' != *p)
+          break;
+        p++;
+      }
+      p = scanInt(p, end, *fields[i]);
+    }
+    while (p < end && !isEndOfToken(*p))
+      p++;
+    return p;
+  }
+
+  void parse(const char *begin, const char *end) {
+    using namespace textscan;
+    int matIndex = -1;
+    for (const char *line = begin; line < end; line = nextLine(line, end)) {
+      if (end - line < 2)
+        break;
+
+      if ('v' == line[0] && ' ' == line[1]) {
+        Vector3 v;
+        scanFloats(line + 2, end, v.xyz, 3);
+        pts.push_back(v);
+      }
+
+      else if ('v' == line[0] && 'n' == line[1]) {
+        Vector3 v;
+        scanFloats(line + 2, end, v.xyz, 3);
+        nos.push_back(v);
+      }
+
+      else if ('v' == line[0] && 't' == line[1]) {
+        Vector2 v;
+        scanFloats(line + 2, end, v.xy, 2);
+        uvs.push_back(v);
+      }
+
+      else if (end - line > 6 && 0 == memcmp("usemtl", line, 6)) {
+        const char *p = skipBlanks(line + 6, end);
+        const char *q = p;
+        while (q < end && !isEndOfToken(*q))
+          q++;
+        mats.push_back(std::string(p, q));
+        matIndex = (int) mats.size() - 1;
+      }
+
+      else if ('f' == line[0] && ' ' == line[1]) {
+        OBJ::Face face;
+        face.m = matIndex;
+        const char *p = line + 2;
+        for (int i = 0; i < 3; i++) {
+          face.vs[i].p = face.vs[i].n = face.vs[i].uv = 0;
+          p = scanCorner(p, end, face.vs[i]);
+        }
+        faces.push_back(face);
+      }
+    }
+  }
+};
+
+}
+
+bool OBJ::Vertex::operator <(const Vertex &rhs) const {
+  if (p < rhs.p)
+    return true;
+  if (p > rhs.p)
+    return false;
+
+  if (n < rhs.n)
+    return true;
+  if (n > rhs.n)
+    return false;
+
+  if (t < rhs.t)
+    return true;
+  if (t > rhs.t)
+    return false;
+
+  return false;
+}
+
+bool OBJ::Vertex::operator >(const Vertex &rhs) const {
+  return rhs < *this;
+}
+
+bool OBJ::Vertex::operator ==(const Vertex &rhs) const {
+  return !(*this < rhs) && !(rhs < *this);
+}
+
+bool OBJ::load(std::string_view fileName, uint32 numThreads) {
+  const char *tag = "Obj::Load";
+
+  //0,1,2, info/warn/error
+  auto print = [&](int type, std::string_view format, ...) {
+    std::stringstream ss;
+    char buffer[1024];
+    if (0 == type)
+      ss << "[INFO]..: " << tag << " - ";
+    if (1 == type)
+      ss << "[WARN]..: " << tag << " - ";
+    if (2 == type)
+      ss << "[ERROR].: " << tag << " - ";
+
+    va_list args;
+    va_start(args, format);
+    vsnprintf(buffer, sizeof(buffer), format.data(), args);
+    va_end(args);
+    ss << buffer;
+    printf("%s\n", ss.str().c_str());
+  };
+
+  MappedFile file(fileName);
+
+  if (!file.valid()) {
+    print(2, "file '%s' not found", fileName.data());
+    return false;
+  }
+
+  auto lines = splitLines(file.begin(), file.end(), numThreads);
+  print(0, "loading OBJ from file '%s' (%zu chunks)", fileName.data(), lines.size());
+
+  pts.clear();
+  nos.clear();
+  uvs.clear();
+  mats.clear();
+  faces.clear();
+  vertices.clear();
+  indices.clear();
+  ranges.clear();
+
+  std::vector<OBJChunk> chunks(lines.size());
+  forEachChunk(lines, [&](size_t i, const char *begin, const char *end) {
+    chunks[i].parse(begin, end);
+  });
+
+  // stitch the chunks in file order: chunk-local material indices are mapped to unique material ids
+  // (one name lookup per 'usemtl', never per face), and faces that precede the chunk's first 'usemtl'
+  // inherit whatever material was current at the end of the previous chunk
+  size_t numPts = 0, numNos = 0, numUvs = 0, numFaces = 0;
+  for (const auto &chunk : chunks) {
+    numPts += chunk.pts.size();
+    numNos += chunk.nos.size();
+    numUvs += chunk.uvs.size();
+    numFaces += chunk.faces.size();
+  }
+  pts.reserve(numPts);
+  nos.reserve(numNos);
+  uvs.reserve(numUvs);
+
+  std::map<std::string, int> matIds;
+  matIds["__default__"] = 0;
+  mats.push_back("__default__");
+  int matIndex = 0;
+  std::vector<int> chunkMats;
+  for (auto &chunk : chunks) {
+    pts.insert(pts.end(), chunk.pts.begin(), chunk.pts.end());
+    nos.insert(nos.end(), chunk.nos.begin(), chunk.nos.end());
+    uvs.insert(uvs.end(), chunk.uvs.begin(), chunk.uvs.end());
+    chunkMats.clear();
+    for (auto &name : chunk.mats) {
+      auto it = matIds.find(name);
+      if (it == matIds.end()) {
+        it = matIds.emplace(name, (int) mats.size()).first;
+        mats.push_back(std::move(name));
+      }
+      chunkMats.push_back(it->second);
+    }
+    for (auto &face : chunk.faces)
+      face.m = face.m < 0 ? matIndex : chunkMats[face.m];
+    if (chunkMats.size())
+      matIndex = chunkMats.back();
+  }
+
+  // counting sort by material, faces keep their file order within a material
+  std::vector<uint32> firstFace(mats.size() + 1, 0);
+  for (const auto &chunk : chunks)
+    for (const auto &face : chunk.faces)
+      firstFace[face.m + 1]++;
+  for (size_t m = 1; m < firstFace.size(); m++)
+    firstFace[m] += firstFace[m - 1];
+  std::vector<uint32> nextFace(firstFace.begin(), firstFace.end() - 1);
+  faces.resize(numFaces);
+  for (const auto &chunk : chunks)
+    for (const auto &face : chunk.faces)
+      faces[nextFace[face.m]++] = face;
+  chunks.clear();
+
+  for (size_t m = 0; m + 1 < firstFace.size(); m++) {
+    if (firstFace[m + 1] > firstFace[m])
+      ranges.push_back(Range { (int32) m, firstFace[m] * 3, (firstFace[m + 1] - firstFace[m]) * 3 });
+  }
+
+  VertexIndexer indexer;
+  indexer.reserve(faces.size() * 3);
+  indices.reserve(faces.size() * 3);
+  for (auto &f : faces) {
+    for (int i = 0; i < 3; i++) {
+      uint32 id = indexer.index(f.vs[i].p, f.vs[i].n, f.vs[i].uv);
+      if (id == vertices.size()) {
+        Vertex v;
+        v.p = pts[f.vs[i].p - 1];
+        v.n = nos[f.vs[i].n - 1];
+        v.t = uvs[f.vs[i].uv - 1];
+        vertices.push_back(v);
+      }
+      f.ids[i] = (int) id;
+      indices.push_back(id);
+    }
+  }
+
+  return true;
+}
+
+const OBJ::Range* OBJ::findRange(std::string_view material) const {
+  for (const auto &range : ranges) {
+    if (mats[range.material] == material)
+      return &range;
+  }
+  return nullptr;
+}
+
+size_t OBJ::bytes() const {
+  size_t n = pts.capacity() * sizeof(Vector3) + nos.capacity() * sizeof(Vector3) + uvs.capacity() * sizeof(Vector2);
+  n += faces.capacity() * sizeof(Face) + vertices.capacity() * sizeof(Vertex) + indices.data.capacity();
+  n += mats.capacity() * sizeof(std::string) + ranges.capacity() * sizeof(Range);
+  for (const auto &m : mats)
+    n += m.capacity();
+  return n;
+}
+
+bool OBJ::loadMaterials(std::string_view fileName) {
+  const char *tag = "Obj::laodMaterials";
+
+  //0,1,2, info/warn/error
+  auto print = [&](int type, std::string_view format, ...) {
+    std::stringstream ss;
+    char buffer[1024];
+    if (0 == type)
+      ss << "[INFO]..: " << tag << " - ";
+    if (1 == type)
+      ss << "[WARN]..: " << tag << " - ";
+    if (2 == type)
+      ss << "[ERROR].: " << tag << " - ";
+
+    va_list args;
+    va_start(args, format);
+    vsnprintf(buffer, sizeof(buffer), format.data(), args);
+    va_end(args);
+    ss << buffer;
+    printf("%s\n", ss.str().c_str());
+  };
+
+  FILE *fp = fopen(fileName.data(), "r");
+
+  if (!fp) {
+    print(2, "file '%s' not found", fileName.data());
+    return false;
+  }
+  print(0, "loading OBJ materials from file '%s'", fileName.data());
+
+  char line[256];
+  int lineNo = -1;
+  while (fgets(line, sizeof(line), fp)) {
+    lineNo++;
+    if ('#' == line[0])
+      continue;
+    auto *p = strchr(line, '\n');
+    if (p)
+      *p = '\0';
+
+    print(0, "%s", line);
+
+    char *toks[3];
+    toks[0] = strtok(line, " \n");
+    toks[1] = strtok(nullptr, " \n");
+    toks[2] = strtok(nullptr, " \n");
+    if (toks[0] == nullptr || toks[1] == nullptr || toks[2] == nullptr) {
+      print(1, "invalid material at line %d", lineNo);
+    }
+    auto &material = materials[std::string(toks[0])];
+    material.name = std::string(toks[0]);
+    material.albedo.fromHex(toks[1]);
+    material.emission.fromHex(toks[2]);
+  }
+
+  return true;
+}
+
+namespace {
+
+// unique values of one attribute stream as they're written (six decimals, so "%f" text that's equal is one
+// value), ids in first use order; open addressing like VertexIndexer
+struct AttributeSet {
+  struct Key {
+    int64 c[3];
+  };
+
+  std::vector<Key> keys;
+  std::vector<const float*> values;  // values[id], the first one seen
+  std::vector<uint32> slots;         // 0 = empty, otherwise id + 1
+  uint32 mask = 0;
+
+  static uint32 hash(const Key &k) {
+    uint64 h = (uint64) k.c[0] * 0x9E3779B97F4A7C15ull;
+    h ^= (uint64) k.c[1] * 0xC2B2AE3D27D4EB4Full;
+    h ^= (uint64) k.c[2] * 0x165667B19E3779F9ull;
+    h ^= h >> 31;
+    return (uint32) (h ^ (h >> 32));
+  }
+
+  uint32 add(const float *v, int numComponents) {
+    Key key = { { 0, 0, 0 } };
+    for (int i = 0; i < numComponents; i++) {
+      // values that don't fit in six decimals keep their bits, below anything fixed6() can produce
+      if (!TextWriter::fixed6(v[i], key.c[i])) {
+        uint32 bits;
+        memcpy(&bits, &v[i], sizeof(bits));
+        key.c[i] = INT64_MIN + bits;
+      }
+    }
+
+    if ((keys.size() + 1) * 2 > slots.size())
+      rehash(slots.size() ? slots.size() * 2 : 1024);
+    uint32 i = hash(key) & mask;
+    while (slots[i]) {
+      const Key &k = keys[slots[i] - 1];
+      if (k.c[0] == key.c[0] && k.c[1] == key.c[1] && k.c[2] == key.c[2])
+        return slots[i] - 1;
+      i = (i + 1) & mask;
+    }
+    keys.push_back(key);
+    values.push_back(v);
+    slots[i] = (uint32) keys.size();
+    return slots[i] - 1;
+  }
+
+  void rehash(size_t size) {
+    slots.assign(size, 0);
+    mask = (uint32) size - 1;
+    for (uint32 id = 0; id < keys.size(); id++) {
+      uint32 i = hash(keys[id]) & mask;
+      while (slots[i])
+        i = (i + 1) & mask;
+      slots[i] = id + 1;
+    }
+  }
+};
+
+void writeObj(std::string_view fileName, const OBJ &obj, uint32 firstFace, uint32 lastFace, ExportAttributes attributes) {
+  const char *tag = "exportObj";
+  TextWriter out(fileName);
+  if (!out.valid()) {
+    print(2, tag, "failed to open file '%s' for writing", fileName.data());
+    return;
+  }
+
+  auto putLine = [&](std::string_view prefix, const float *v, int numComponents) {
+    out.put(prefix);
+    for (int i = 0; i < numComponents; i++) {
+      out.put(' ');
+      out.putFloat(v[i]);
+    }
+    out.put('\n');
+  };
+
+  char header[512];
+  snprintf(header, sizeof(header), "# %s - %zu vertices / %zu faces\n", fileName.data(), obj.vertices.size(),
+           obj.faces.size());
+  out.put(header);
+
+  if (EXPORT_DEDUPED == attributes) {
+    // every vertex of the exported faces, with each of its attributes written once
+    std::vector<uint32> ids(obj.vertices.size() * 3, ~0u);
+    AttributeSet ps, ns, ts;
+    for (uint32 i = firstFace; i < lastFace; i++) {
+      for (int k = 0; k < 3; k++) {
+        uint32 v = (uint32) obj.faces[i].ids[k];
+        if (~0u != ids[v * 3])
+          continue;
+        const auto &vertex = obj.vertices[v];
+        ids[v * 3 + 0] = ps.add(vertex.p.xyz, 3);
+        ids[v * 3 + 1] = ts.add(vertex.t.xy, 2);
+        ids[v * 3 + 2] = ns.add(vertex.n.xyz, 3);
+      }
+    }
+
+    out.put("# positions:\n");
+    for (const float *v : ps.values)
+      putLine("v", v, 3);
+    out.put("# normals:\n");
+    for (const float *v : ns.values)
+      putLine("vn", v, 3);
+    out.put("# uvs:\n");
+    for (const float *v : ts.values)
+      putLine("vt", v, 2);
+
+    out.put("# faces:\n");
+    for (uint32 i = firstFace; i < lastFace; i++) {
+      out.put('f');
+      for (int k = 0; k < 3; k++) {
+        const uint32 *id = &ids[obj.faces[i].ids[k] * 3];
+        out.put(' ');
+        out.putUint(id[0] + 1);
+        out.put('/');
+        out.putUint(id[1] + 1);
+        out.put('/');
+        out.putUint(id[2] + 1);
+      }
+      out.put('\n');
+    }
+    print(0, tag, "%zu positions, %zu normals, %zu uvs for %zu vertices", ps.values.size(), ns.values.size(),
+          ts.values.size(), obj.vertices.size());
+  } else {
+    out.put("# positions:\n");
+    for (const auto &v : obj.vertices)
+      putLine("v", v.p.xyz, 3);
+    out.put("# normals:\n");
+    for (const auto &v : obj.vertices)
+      putLine("vn", v.n.xyz, 3);
+    out.put("# uvs:\n");
+    for (const auto &v : obj.vertices)
+      putLine("vt", v.t.xy, 2);
+
+    out.put("# faces:\n");
+    for (uint32 i = firstFace; i < lastFace; i++) {
+      out.put('f');
+      for (int k = 0; k < 3; k++) {
+        uint32 id = (uint32) obj.faces[i].ids[k] + 1;
+        out.put(' ');
+        out.putUint(id);
+        out.put('/');
+        out.putUint(id);
+        out.put('/');
+        out.putUint(id);
+      }
+      out.put('\n');
+    }
+  }
+
+  out.close();
+  print(0, tag, "exporting OBJ to file '%s'...", fileName.data());
+  print(0, tag, "%llu bytes in %u writes", (unsigned long long) out.bytesWritten, out.numWrites);
+  print(0, tag, "%s", "done!");
+}
+
+}
+
+void exportObj(std::string_view fileName, const OBJ &obj, ExportAttributes attributes) {
+  writeObj(fileName, obj, 0, (uint32) obj.faces.size(), attributes);
+}
+
+void exportObj(std::string_view fileName, const OBJ &obj, std::string_view material, ExportAttributes attributes) {
+  const OBJ::Range *range = obj.findRange(material);
+  uint32 first = range ? range->firstIndex / 3 : 0;
+  uint32 last = range ? first + range->count / 3 : 0;
+  writeObj(fileName, obj, first, last, attributes);
+}
+
+}
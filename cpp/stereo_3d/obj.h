@@ -1,69 +1,88 @@
-#pragma once
-
-#include <vector>
-#include <string>
-#include <string_view>
-#include <set>
-#include <map>
-
-#include <vector>
-
-#include "defs.h"
-#include "myvector.h"
-
-namespace wavefront {
-
-struct OBJ {
-  struct Material {
-    Color albedo;
-    Color emission;
-    std::string name;
-  };
-
-  struct Vertex {
-    Vector3 p;
-    Vector3 n;
-    Vector2 t;
-
-    bool operator <(const Vertex &rhs) const;
-    bool operator >(const Vertex &rhs) const;
-    bool operator ==(const Vertex &rhs) const;
-  };
-
-  struct Face {
-    struct Vertex {
-      int p;
-      int n;
-      int uv;
-    };
-    union {
-      struct {
-        Vertex v, v2, v3;
-      };
-      Vertex vs[3];
-    };
-    int m;
-    OBJ::Vertex verts[3];
-    int ids[3];
-  };
-
-  std::string fileName;
-  std::map<std::string, Material> materials;
-  std::map<std::string, std::vector<uint32>> materialFaces;
-  std::vector<Vector3> pts;
-  std::vector<Vector3> nos;
-  std::vector<Vector2> uvs;
-  std::vector<std::string> mats;
-  std::vector<Face> faces;
-  std::vector<Vertex> vertices;
-  std::vector<uint16_t> indices;
-
-  OBJ() = default;
-  bool load(std::string_view fileName);
-  bool loadMaterials(std::string_view fileName);
-};
-
-void exportObj(std::string_view fileName, const OBJ &obj);
-void exportObj(std::string_view fileName, OBJ &obj, std::string material);
-
-}
+#pragma once
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <set>
+#include <map>
+
+#include <vector>
+
+#include "defs.h"
+#include "myvector.h"
+#include "indexbuffer.h"
+
+namespace wavefront {
+
+struct OBJ {
+  struct Material {
+    Color albedo;
+    Color emission;
+    std::string name;
+  };
+
+  struct Vertex {
+    Vector3 p;
+    Vector3 n;
+    Vector2 t;
+
+    bool operator <(const Vertex &rhs) const;
+    bool operator >(const Vertex &rhs) const;
+    bool operator ==(const Vertex &rhs) const;
+  };
+
+  struct Face {
+    struct Vertex {
+      int p;
+      int n;
+      int uv;
+    };
+    union {
+      struct {
+        Vertex v, v2, v3;
+      };
+      Vertex vs[3];
+    };
+    int m;
+    int ids[3];       // into vertices
+  };
+
+  // the faces of one material, indices[firstIndex, firstIndex + count)
+  struct Range {
+    int32 material;
+    uint32 firstIndex;
+    uint32 count;
+  };
+
+  std::string fileName;
+  std::map<std::string, Material> materials;
+  std::vector<Vector3> pts;
+  std::vector<Vector3> nos;
+  std::vector<Vector2> uvs;
+  std::vector<std::string> mats;    // unique material names, Face::m and Range::material index into it
+  std::vector<Face> faces;          // sorted by material, faces[i] is indices[i * 3 .. i * 3 + 2]
+  std::vector<Vertex> vertices;
+  IndexBuffer indices;              // 16-bit unless there are more than 65536 vertices
+  std::vector<Range> ranges;        // one per material in use, in 'mats' order
+
+  OBJ() = default;
+  // numThreads: 1 parses serially, 0 uses every hardware thread; the result is identical either way
+  bool load(std::string_view fileName, uint32 numThreads = 1);
+  bool loadMaterials(std::string_view fileName);
+  const Range* findRange(std::string_view material) const;
+  size_t bytes() const;  // heap held, for memory reports
+};
+
+// EXPORT_PER_VERTEX writes the position, normal and UV of every vertex and faces as "f i/i/i";
+// EXPORT_DEDUPED writes each distinct (as printed) position, normal and UV once and only for the
+// vertices the exported faces use, the faces index the three streams separately
+enum ExportAttributes {
+  EXPORT_PER_VERTEX,
+  EXPORT_DEDUPED,
+};
+
+void exportObj(std::string_view fileName, const OBJ &obj, ExportAttributes attributes = EXPORT_PER_VERTEX);
+void exportObj(std::string_view fileName, const OBJ &obj, std::string_view material,
+               ExportAttributes attributes = EXPORT_PER_VERTEX);
+
+}
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cstdio>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "defs.h"
+
+// buffered text output: everything is formatted straight into a large buffer that is handed to the
+// file in one write whenever it fills up, instead of a formatted stdio call per value
+struct TextWriter {
+  std::string name;
+  FILE *fp = nullptr;
+  std::vector<char> buffer;
+  size_t used = 0;
+  uint64 bytesWritten = 0;
+  uint32 numWrites = 0;
+
+  TextWriter() = default;
+  TextWriter(std::string_view fileName, size_t bufferSize = 1 << 20) {
+    open(fileName, bufferSize);
+  }
+  ~TextWriter() {
+    close();
+  }
+  TextWriter(const TextWriter&) = delete;
+  TextWriter& operator =(const TextWriter&) = delete;
+
+  bool valid() const {
+    return fp != nullptr;
+  }
+
+  bool open(std::string_view fileName, size_t bufferSize = 1 << 20) {
+    close();
+    name = fileName;
+    fp = fopen(name.c_str(), "w");
+    if (!fp)
+      return false;
+    // the buffer below is the only one, each flush is a single write
+    setvbuf(fp, nullptr, _IONBF, 0);
+    buffer.resize(bufferSize < 256 ? 256 : bufferSize);
+    used = 0;
+    bytesWritten = 0;
+    numWrites = 0;
+    return true;
+  }
+
+  void close() {
+    if (!fp)
+      return;
+    flush();
+    fclose(fp);
+    fp = nullptr;
+  }
+
+  void flush() {
+    if (used && fp) {
+      fwrite(buffer.data(), 1, used, fp);
+      bytesWritten += used;
+      numWrites++;
+    }
+    used = 0;
+  }
+
+  // room for 'n' more characters
+  char* reserve(size_t n) {
+    if (used + n > buffer.size())
+      flush();
+    return buffer.data() + used;
+  }
+
+  void put(char c) {
+    *reserve(1) = c;
+    used++;
+  }
+
+  void put(std::string_view s) {
+    if (s.size() > buffer.size()) {
+      flush();
+      fwrite(s.data(), 1, s.size(), fp);
+      bytesWritten += s.size();
+      numWrites++;
+      return;
+    }
+    memcpy(reserve(s.size()), s.data(), s.size());
+    used += s.size();
+  }
+
+  void putUint(uint64 v) {
+    char digits[20];
+    int n = 0;
+    do {
+      digits[n++] = (char) ('0' + v % 10);
+      v /= 10;
+    } while (v);
+    char *p = reserve(n);
+    for (int i = 0; i < n; i++)
+      p[i] = digits[n - 1 - i];
+    used += n;
+  }
+
+  // 'f' scaled by 1e6 and rounded like printf() rounds "%f": a float times 1e6 needs at most 44 significant
+  // bits, so the product is exact in a double and rint() does the round-half-even printf() does on the exact
+  // value; false if the result doesn't fit (huge, inf or nan)
+  static bool fixed6(float f, int64 &q) {
+    double scaled = (double) f * 1e6;
+    if (!(fabs(scaled) < 9.0e18))
+      return false;
+    q = (int64) rint(scaled);
+    return true;
+  }
+
+  // same text as printf("%f", f)
+  void putFloat(float f) {
+    int64 q;
+    if (!fixed6(f, q)) {
+      char *p = reserve(64);
+      used += snprintf(p, 64, "%f", f);
+      return;
+    }
+    // the sign of anything rounding to zero is kept too: "-0.000000"
+    if (std::signbit(f))
+      put('-');
+    uint64 a = (uint64) (q < 0 ? -q : q);
+    putUint(a / 1000000);
+    char *p = reserve(7);
+    p[0] = '.';
+    uint32 frac = (uint32) (a % 1000000);
+    for (int i = 6; i >= 1; i--) {
+      p[i] = (char) ('0' + frac % 10);
+      frac /= 10;
+    }
+    used += 7;
+  }
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+
+#include "defs.h"
+
+// maps (vp, vn, vt) corner triples to dense vertex ids, handed out in first-seen order;
+// open addressing with linear probing over flat arrays, so there is no per-vertex allocation
+struct VertexIndexer {
+  struct Key {
+    int32 vp, vn, vt;
+  };
+
+  std::vector<Key> keys;      // unique triples, keys[id]
+  std::vector<uint32> slots;  // 0 = empty, otherwise id + 1
+  uint32 mask = 0;
+
+  static uint32 hash(int32 vp, int32 vn, int32 vt) {
+    uint64 h = (uint64) (uint32) vp * 0x9E3779B97F4A7C15ull;
+    h ^= (uint64) (uint32) vn * 0xC2B2AE3D27D4EB4Full;
+    h ^= (uint64) (uint32) vt * 0x165667B19E3779F9ull;
+    h ^= h >> 31;
+    return (uint32) (h ^ (h >> 32));
+  }
+
+  // sizes the table for up to 'numCorners' unique corners (at most half full)
+  void reserve(size_t numCorners) {
+    keys.reserve(numCorners);
+    size_t size = 16;
+    while (size < numCorners * 2)
+      size *= 2;
+    if (size > slots.size())
+      rehash(size);
+  }
+
+  void clear() {
+    keys.clear();
+    std::fill(slots.begin(), slots.end(), 0);
+  }
+
+  size_t size() const {
+    return keys.size();
+  }
+
+  // returns the id of the triple, adding it if it hasn't been seen; a new id always equals size() - 1
+  uint32 index(int32 vp, int32 vn, int32 vt) {
+    if ((keys.size() + 1) * 2 > slots.size())
+      rehash(slots.size() ? slots.size() * 2 : 16);
+
+    uint32 i = hash(vp, vn, vt) & mask;
+    while (slots[i]) {
+      const Key &k = keys[slots[i] - 1];
+      if (k.vp == vp && k.vn == vn && k.vt == vt)
+        return slots[i] - 1;
+      i = (i + 1) & mask;
+    }
+    keys.push_back(Key { vp, vn, vt });
+    slots[i] = (uint32) keys.size();
+    return slots[i] - 1;
+  }
+
+  void rehash(size_t size) {
+    slots.assign(size, 0);
+    mask = (uint32) size - 1;
+    for (uint32 id = 0; id < keys.size(); id++) {
+      uint32 i = hash(keys[id].vp, keys[id].vn, keys[id].vt) & mask;
+      while (slots[i])
+        i = (i + 1) & mask;
+      slots[i] = id + 1;
+    }
+  }
+};